@@ -1,33 +1,36 @@
 /*
- * 標準 ASCII 和中文字體定義
- * 
- * 字體格式：
- * - ASCII: 8x16 點陣 (完整 printable ASCII 0x20-0x7E)
- * - 中文: 16x16 點陣 (常用漢字)
- * 
- * 版本: v2.0
- * 日期: 2025-10-28
+ * 標準 ASCII 和中文字體資料
+ *
+ * 所有字形只在這個檔案定義一次 (font.h 只有宣告)，
+ * 不論有多少個 .c 檔 include font.h，映像檔中都只有一份字體資料。
+ *
+ * 版本: v2.2
+ * 日期: 2025-11-14
  */
 
-#ifndef FONT_H
-#define FONT_H
+#include <stddef.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "font.h"
+#include "utf8.h"
 
-#include <stdint.h>
-#include <stdbool.h>
-#include <string.h>
+static const char *TAG = "Font";
 
-// ============================================
-// 8x16 標準 ASCII 字體 (簡化版)
-// ============================================
+#define MISSING_REPORT_SLOTS    16      // 記住最近回報過的缺字，避免每次重繪都輸出
 
-// 由於完整 ASCII 字體需要 ~15KB，這裡提供常用字符
-// 如需完整字體，可以從標準字體庫轉換
+#ifdef CONFIG_EPAPER_FONT_SUBSET
+// 由 tools/font_subset.py 在編譯時產生 (font_subset.c)
+extern const uint16_t font_subset_count;
+extern const uint32_t font_subset_codepoints[];
+extern const uint8_t font_subset_glyphs[][32];
+#endif
 
-// 支援的字符範圍
-static const char supported_ascii[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+// ============================================
+// 8x16 標準 ASCII 字體
+// ============================================
 
 // 標準 8x16 ASCII 字體資料 (0x20-0x7E)
-static const uint8_t font_ascii_8x16[][16] = {
+const uint8_t font_ascii_8x16[FONT_ASCII_COUNT][16] = {
     // 0x20: ' ' (空格)
     {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
     // 0x21: '!'
@@ -147,8 +150,8 @@ static const uint8_t font_ascii_8x16[][16] = {
     {0x00,0x00,0x76,0xDC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '~'
 };
 
-// 取得 ASCII 字符的字體資料
-static inline const uint8_t* get_ascii_font(char c) {
+const uint8_t *get_ascii_font(char c)
+{
     if (c >= 0x20 && c <= 0x7E) {
         return font_ascii_8x16[c - 0x20];
     }
@@ -159,12 +162,6 @@ static inline const uint8_t* get_ascii_font(char c) {
 // 16x16 常用中文字體
 // ============================================
 
-// 中文字體結構
-typedef struct {
-    const char *utf8;    // UTF-8 編碼
-    const uint8_t *data; // 16x16 點陣資料 (32 bytes)
-} chinese_font_t;
-
 // 16x16 中文點陣字體資料
 // "中" - U+4E2D
 static const uint8_t font_zhong[] = {
@@ -246,29 +243,101 @@ static const uint8_t font_mu[] = {
     0x04,0x60,0x08,0x10,0x10,0x0C,0x20,0x04
 };
 
-// 常用漢字字體表
+// 常用漢字字體表 (依碼位排序，供二分搜尋；新增字元時需維持排序)
 static const chinese_font_t chinese_fonts[] = {
-    {"中", font_zhong},
-    {"文", font_wen},
-    {"測", font_ce},
-    {"試", font_shi},
-    {"顯", font_xian},
-    {"示", font_shi2},
-    {"電", font_dian},
-    {"子", font_zi},
-    {"屏", font_ping},
-    {"幕", font_mu},
+    {0x4E2D, font_zhong},   // 中
+    {0x5B50, font_zi},      // 子
+    {0x5C4F, font_ping},    // 屏
+    {0x5E55, font_mu},      // 幕
+    {0x6587, font_wen},     // 文
+    {0x6E2C, font_ce},      // 測
+    {0x793A, font_shi2},    // 示
+    {0x8A66, font_shi},     // 試
+    {0x96FB, font_dian},    // 電
+    {0x986F, font_xian},    // 顯
 };
 
-// 取得中文字符的字體資料
-static inline const uint8_t* get_chinese_font(const char *utf8_char) {
-    int num_fonts = sizeof(chinese_fonts) / sizeof(chinese_font_t);
-    for (int i = 0; i < num_fonts; i++) {
-        if (strncmp(utf8_char, chinese_fonts[i].utf8, 3) == 0) {
-            return chinese_fonts[i].data;
+#define CHINESE_FONT_COUNT  (sizeof(chinese_fonts) / sizeof(chinese_fonts[0]))
+
+const uint8_t *get_chinese_font_cp(uint32_t codepoint)
+{
+    // 二分搜尋，O(log n)
+    int lo = 0;
+    int hi = (int)CHINESE_FONT_COUNT - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        uint32_t cp = chinese_fonts[mid].codepoint;
+        if (cp == codepoint) {
+            return chinese_fonts[mid].data;
+        }
+        if (cp < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
         }
     }
+
+#ifdef CONFIG_EPAPER_FONT_SUBSET
+    // 編譯時產生的字型子集
+    lo = 0;
+    hi = (int)font_subset_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        uint32_t cp = font_subset_codepoints[mid];
+        if (cp == codepoint) {
+            return font_subset_glyphs[mid];
+        }
+        if (cp < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+#endif
     return NULL;
 }
 
-#endif // FONT_H
+const uint8_t *get_chinese_font(const char *utf8_char)
+{
+    if (utf8_char == NULL || *utf8_char == '\0') {
+        return NULL;
+    }
+    return get_chinese_font_cp(utf8_next(&utf8_char));
+}
+
+// ============================================
+// 替代字形
+// ============================================
+
+// 缺字時顯示的替代字形 (外框方塊)
+const uint8_t font_replacement_8x16[16] = {
+    0x00,0x00,0x7E,0x42,0x42,0x42,0x42,0x42,
+    0x42,0x42,0x42,0x42,0x42,0x7E,0x00,0x00
+};
+
+const uint8_t font_replacement_16x16[32] = {
+    0x00,0x00,0x7F,0xFE,0x40,0x02,0x40,0x02,
+    0x40,0x02,0x40,0x02,0x40,0x02,0x40,0x02,
+    0x40,0x02,0x40,0x02,0x40,0x02,0x40,0x02,
+    0x40,0x02,0x40,0x02,0x7F,0xFE,0x00,0x00
+};
+
+void font_report_missing(uint32_t codepoint)
+{
+    static uint32_t reported[MISSING_REPORT_SLOTS];
+    static uint8_t next = 0;
+
+    for (int i = 0; i < MISSING_REPORT_SLOTS; i++) {
+        if (reported[i] == codepoint) {
+            return;
+        }
+    }
+    reported[next] = codepoint;
+    next = (next + 1) % MISSING_REPORT_SLOTS;
+
+#ifdef CONFIG_EPAPER_FONT_SUBSET
+    ESP_LOGW(TAG, "U+%04lX is not in the font subset, add it to the string manifest", codepoint);
+#else
+    ESP_LOGW(TAG, "No glyph for U+%04lX", codepoint);
+#endif
+}
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+"""
+產生查表基準測試用的合成字型：Unifont 格式的 .hex 與字串清單
+
+字形點陣的前 4 bytes 是碼位 (大端序)，測試程式可以驗證查到的是正確的字形。
+輸出交給 ../tools/font_subset.py 產生字型子集，與韌體的建置流程相同。
+
+    python gen_test_font.py count font.hex manifest.txt
+"""
+import sys
+
+FIRST = 0x20000                 # CJK 擴充 B，避開 font.c 內建的常用漢字
+STRIDE = 3                      # 碼位不連續，接近實際字串清單的分佈
+
+
+def main():
+    count = int(sys.argv[1])
+    codepoints = [FIRST + i * STRIDE for i in range(count)]
+
+    with open(sys.argv[2], 'w', encoding='ascii') as f:
+        for cp in codepoints:
+            data = cp.to_bytes(4, 'big') + bytes((cp + i) & 0xFF for i in range(28))
+            f.write('{:04X}:{}\n'.format(cp, data.hex().upper()))
+
+    with open(sys.argv[3], 'w', encoding='utf-8') as f:
+        f.write('# 合成字型的所有字元\n')
+        for i in range(0, count, 64):
+            f.write(''.join(chr(cp) for cp in codepoints[i:i + 64]) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,12 @@
+/*
+ * 主機端測試用 sdkconfig.h
+ *
+ * 啟用字型子集，讓查表基準測試包含編譯時產生的大型字形表
+ */
+
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+#define CONFIG_EPAPER_FONT_SUBSET 1
+
+#endif // HOST_SDKCONFIG_H
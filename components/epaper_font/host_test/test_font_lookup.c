@@ -0,0 +1,131 @@
+/*
+ * get_chinese_font_cp() 主機端查表基準測試
+ *
+ * 以 gen_test_font.py + font_subset.py 產生的大型字型子集 (預設 6000 字) 查詢：
+ * - 子集中的每個字都要查到自己的點陣 (點陣前 4 bytes 是碼位)，不在字型中的碼位回傳 NULL
+ * - 量測命中 / 未命中的 ns/次，並與逐一比對的線性搜尋比較
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "font.h"
+
+// 由 font_subset.py 產生
+extern const uint16_t font_subset_count;
+extern const uint32_t font_subset_codepoints[];
+extern const uint8_t font_subset_glyphs[][32];
+
+#define BENCH_ROUNDS    200
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t glyph_codepoint(const uint8_t *glyph)
+{
+    return ((uint32_t)glyph[0] << 24) | (glyph[1] << 16) | (glyph[2] << 8) | glyph[3];
+}
+
+/**
+ * 逐一比對的線性搜尋 (改用二分搜尋之前的做法)，作為比較基準
+ */
+static const uint8_t *linear_lookup(uint32_t codepoint)
+{
+    for (uint16_t i = 0; i < font_subset_count; i++) {
+        if (font_subset_codepoints[i] == codepoint) {
+            return font_subset_glyphs[i];
+        }
+    }
+    return NULL;
+}
+
+static int verify(void)
+{
+    int failures = 0;
+
+    for (uint16_t i = 0; i < font_subset_count; i++) {
+        uint32_t cp = font_subset_codepoints[i];
+        const uint8_t *glyph = get_chinese_font_cp(cp);
+        if (glyph == NULL || glyph_codepoint(glyph) != cp) {
+            printf("FAIL: U+%04X -> %p\n", (unsigned)cp, (const void *)glyph);
+            failures++;
+        }
+        // 相鄰但不在字型中的碼位
+        if (get_chinese_font_cp(cp + 1) != NULL) {
+            printf("FAIL: U+%04X should not be found\n", (unsigned)(cp + 1));
+            failures++;
+        }
+    }
+
+    // 內建字 (font.c 的常用漢字表) 仍然查得到
+    if (get_chinese_font_cp(0x4E2D) == NULL) {
+        printf("FAIL: built-in U+4E2D not found\n");
+        failures++;
+    }
+    if (get_chinese_font_cp(0) != NULL || get_chinese_font_cp(0x10FFFF) != NULL) {
+        printf("FAIL: out-of-range lookup returned a glyph\n");
+        failures++;
+    }
+    return failures;
+}
+
+/**
+ * 查詢 queries 中的每個碼位 rounds 次，回傳 ns/次
+ */
+static double bench(const uint8_t *(*lookup)(uint32_t), const uint32_t *queries, size_t n, int rounds)
+{
+    uintptr_t sink = 0;
+    double start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < n; i++) {
+            sink += (uintptr_t)lookup(queries[i]);
+        }
+    }
+    double elapsed = now_ns() - start;
+    // 避免編譯器把查詢整個省略
+    if (sink == 1) {
+        printf("\n");
+    }
+    return elapsed / ((double)n * rounds);
+}
+
+int main(void)
+{
+    size_t n = font_subset_count;
+    int failures = verify();
+    printf("font lookup: %zu subset glyphs, %d failures\n", n, failures);
+
+    // 命中：亂序查詢所有字；未命中：子集碼位之間的空隙
+    uint32_t *hits = malloc(n * sizeof(uint32_t));
+    uint32_t *misses = malloc(n * sizeof(uint32_t));
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < n; i++) {
+        hits[i] = font_subset_codepoints[i];
+        misses[i] = font_subset_codepoints[i] + 1;
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+        seed = seed * 1103515245 + 12345;
+        size_t j = (seed >> 8) % (i + 1);
+        uint32_t t = hits[i];
+        hits[i] = hits[j];
+        hits[j] = t;
+    }
+
+    printf("  binary  hit %7.1f ns  miss %7.1f ns\n",
+           bench(get_chinese_font_cp, hits, n, BENCH_ROUNDS),
+           bench(get_chinese_font_cp, misses, n, BENCH_ROUNDS));
+    printf("  linear  hit %7.1f ns  miss %7.1f ns\n",
+           bench(linear_lookup, hits, n, BENCH_ROUNDS / 20),
+           bench(linear_lookup, misses, n, BENCH_ROUNDS / 20));
+
+    free(hits);
+    free(misses);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+/*
+ * utf8_next() 主機端模糊測試與基準測試
+ *
+ * fuzz [次數]   隨機位元組字串 (含截斷、過長、代理對、超出範圍的序列) 檢查下列性質：
+ *               - 每次至少前進 1 byte，且不會越過結尾 '\0'
+ *               - 回傳值是 UTF8_REPLACEMENT 或合法碼位，合法碼位重新編碼後與消耗的位元組完全相同
+ *               - 輸入中的每個 ASCII 位元組都會原樣解出 (不合法序列不會吞掉後面的字元)
+ *               另外以隨機碼位編碼出的合法字串做來回測試
+ * bench [MB]    解碼 ASCII / 中文 / 混合文字，輸出 ns/字元 與 MB/s
+ *
+ * 以 -DUTF8_LIBFUZZER 編譯時改為 libFuzzer 進入點 (clang -fsanitize=fuzzer)
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "utf8.h"
+
+// ============================================
+// 輔助函數
+// ============================================
+
+/**
+ * 將碼位編碼成 UTF-8 (不檢查是否為合法碼位)，回傳長度
+ */
+static int encode(uint32_t cp, uint8_t *out)
+{
+    if (cp < 0x80) {
+        out[0] = (uint8_t)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = 0xC0 | (cp >> 6);
+        out[1] = 0x80 | (cp & 0x3F);
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = 0xE0 | (cp >> 12);
+        out[1] = 0x80 | ((cp >> 6) & 0x3F);
+        out[2] = 0x80 | (cp & 0x3F);
+        return 3;
+    }
+    out[0] = 0xF0 | (cp >> 18);
+    out[1] = 0x80 | ((cp >> 12) & 0x3F);
+    out[2] = 0x80 | ((cp >> 6) & 0x3F);
+    out[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
+
+static inline bool is_scalar(uint32_t cp)
+{
+    return cp <= 0x10FFFF && (cp < 0xD800 || cp > 0xDFFF);
+}
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void)
+{
+    // xorshift32：結果可重現，不依賴 libc rand()
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ============================================
+// 性質檢查
+// ============================================
+
+/**
+ * 解碼以 '\0' 結尾的 buf[0..len)，檢查所有性質
+ *
+ * @return 0 成功；失敗時輸出原因與輸入內容
+ */
+static int check_string(const uint8_t *buf, size_t len)
+{
+    const char *start = (const char *)buf;
+    const char *end = start + len;
+    const char *p = start;
+    size_t ascii_in = 0, ascii_out = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] < 0x80) {
+            ascii_in++;
+        }
+    }
+
+    while (*p != '\0') {
+        const char *before = p;
+        uint32_t cp = utf8_next(&p);
+        size_t used = (size_t)(p - before);
+
+        if (used == 0 || p > end) {
+            printf("FAIL: advanced %zu bytes at offset %zu (len %zu)\n", used, (size_t)(before - start), len);
+            goto fail;
+        }
+        if (cp < 0x80) {
+            ascii_out++;
+        }
+        if (cp != UTF8_REPLACEMENT) {
+            uint8_t enc[4];
+            int n = encode(cp, enc);
+            if (!is_scalar(cp) || (size_t)n != used || memcmp(enc, before, used) != 0) {
+                printf("FAIL: U+%04X decoded from %zu bytes at offset %zu\n",
+                       (unsigned)cp, used, (size_t)(before - start));
+                goto fail;
+            }
+        }
+    }
+
+    if (ascii_in != ascii_out) {
+        printf("FAIL: %zu ASCII bytes in, %zu decoded\n", ascii_in, ascii_out);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    printf("  input:");
+    for (size_t i = 0; i < len; i++) {
+        printf(" %02X", buf[i]);
+    }
+    printf("\n");
+    return 1;
+}
+
+/**
+ * 產生容易觸發邊界情況的隨機位元組：前導位元組、延續位元組、
+ * 過長編碼與代理對的前綴比例較高
+ */
+static uint8_t fuzz_byte(void)
+{
+    static const uint8_t edge[] = {
+        0x00, 0x7F, 0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xED,
+        0xEF, 0xF0, 0xF4, 0xF5, 0xF7, 0xF8, 0xFF, 0x9F, 0xA0, 0x8F, 0x90,
+    };
+    uint32_t r = rng();
+    switch (r & 3) {
+        case 0:  return edge[(r >> 8) % sizeof(edge)];
+        case 1:  return 0x80 | ((r >> 8) & 0x3F);   // 延續位元組
+        default: return (uint8_t)(r >> 8);
+    }
+}
+
+static int fuzz(uint32_t iterations)
+{
+    uint8_t buf[40];
+    int failures = 0;
+
+    // 隨機位元組 (中間的 0x00 截斷字串，與韌體收到的字串相同)
+    for (uint32_t it = 0; it < iterations && failures < 10; it++) {
+        size_t len = rng() % (sizeof(buf) - 1);
+        for (size_t i = 0; i < len; i++) {
+            buf[i] = fuzz_byte();
+        }
+        buf[len] = '\0';
+        failures += check_string(buf, strlen((const char *)buf));
+    }
+
+    // 合法字串來回測試
+    for (uint32_t it = 0; it < iterations / 4 && failures < 10; it++) {
+        uint32_t cps[8];
+        size_t count = 1 + rng() % 8;
+        size_t len = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t cp;
+            do {
+                uint32_t r = rng();
+                // 各種長度的碼位都要涵蓋
+                static const uint32_t limit[] = { 0x7F, 0x7FF, 0xFFFF, 0x10FFFF };
+                cp = 1 + r % limit[(r >> 28) & 3];
+            } while (!is_scalar(cp));
+            cps[i] = cp;
+            len += encode(cp, buf + len);
+        }
+        buf[len] = '\0';
+
+        const char *p = (const char *)buf;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t cp = utf8_next(&p);
+            if (cp != cps[i]) {
+                printf("FAIL: round trip U+%04X decoded as U+%04X\n", (unsigned)cps[i], (unsigned)cp);
+                failures++;
+                break;
+            }
+        }
+        if (*p != '\0') {
+            printf("FAIL: round trip left %zu bytes\n", strlen(p));
+            failures++;
+        }
+    }
+
+    printf("utf8 fuzz: %lu iterations, %d failures\n", (unsigned long)iterations, failures);
+    return failures ? 1 : 0;
+}
+
+// ============================================
+// 基準測試
+// ============================================
+
+/**
+ * 以 pattern 填滿 size bytes (不切斷多位元組字元) 後解碼 rounds 次
+ */
+static void bench_case(const char *name, const char *pattern, size_t size, int rounds)
+{
+    size_t plen = strlen(pattern);
+    char *buf = malloc(size + 1);
+    size_t len = 0;
+    while (len + plen <= size) {
+        memcpy(buf + len, pattern, plen);
+        len += plen;
+    }
+    buf[len] = '\0';
+
+    uint32_t checksum = 0;
+    size_t chars = 0;
+    double start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        const char *p = buf;
+        while (*p != '\0') {
+            checksum += utf8_next(&p);
+            chars++;
+        }
+    }
+    double elapsed = now_ns() - start;
+
+    printf("  %-8s %6.2f ns/char  %7.1f MB/s  (%zu chars, checksum %08X)\n",
+           name, elapsed / chars, (double)len * rounds / elapsed * 1e3, chars, (unsigned)checksum);
+    free(buf);
+}
+
+static int bench(uint32_t megabytes)
+{
+    size_t size = (size_t)megabytes * 1024 * 1024;
+    printf("utf8 decode benchmark (%lu MB per case):\n", (unsigned long)megabytes);
+    bench_case("ascii", "Temperature 23.5 C, humidity 61% ", size, 1);
+    bench_case("cjk", "今日天氣晴朗，室內溫度攝氏二十三度。", size, 1);
+    bench_case("mixed", "室溫 23.5°C 濕度 61% \xF0\x9F\x8C\xA4 ", size, 1);
+    bench_case("invalid", "\xC0\xAF\xE0\x80\xED\xA0\x80\xF8" "a\x80", size, 1);
+    return 0;
+}
+
+// ============================================
+// 進入點
+// ============================================
+
+#ifdef UTF8_LIBFUZZER
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uint8_t *buf = malloc(size + 1);
+    memcpy(buf, data, size);
+    buf[size] = '\0';
+    if (check_string(buf, strlen((const char *)buf)) != 0) {
+        abort();
+    }
+    free(buf);
+    return 0;
+}
+#else
+int main(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "fuzz";
+    uint32_t n = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+
+    if (strcmp(mode, "fuzz") == 0) {
+        return fuzz(n ? n : 1000000);
+    }
+    if (strcmp(mode, "bench") == 0) {
+        return bench(n ? n : 16);
+    }
+    fprintf(stderr, "usage: %s fuzz [iterations] | bench [MB]\n", argv[0]);
+    return 2;
+}
+#endif
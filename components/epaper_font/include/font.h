@@ -0,0 +1,75 @@
+/*
+ * 標準 ASCII 和中文字體定義
+ *
+ * 字體格式：
+ * - ASCII: 8x16 點陣 (完整 printable ASCII 0x20-0x7E)
+ * - 中文: 16x16 點陣 (常用漢字)，依碼位排序供二分搜尋
+ *
+ * 字體資料定義在 font.c (epaper_font component)，這裡只有宣告，
+ * esp32c3_spi_display 與 esp32c3_wifi_display 共用同一份字體。
+ * 啟用 CONFIG_EPAPER_FONT_SUBSET 時，另外加入編譯時依字串清單產生的字型子集。
+ *
+ * 版本: v2.2
+ * 日期: 2025-11-14
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FONT_ASCII_FIRST    0x20
+#define FONT_ASCII_COUNT    (0x7E - FONT_ASCII_FIRST + 1)
+
+// 中文字體結構
+typedef struct {
+    uint32_t codepoint;  // Unicode 碼位
+    const uint8_t *data; // 16x16 點陣資料 (32 bytes)
+} chinese_font_t;
+
+// 標準 8x16 ASCII 字體資料 (0x20-0x7E)
+extern const uint8_t font_ascii_8x16[FONT_ASCII_COUNT][16];
+
+// 缺字時顯示的替代字形 (外框方塊)
+extern const uint8_t font_replacement_8x16[16];
+extern const uint8_t font_replacement_16x16[32];
+
+/**
+ * 取得 ASCII 字符的字體資料 (不支援的字元回傳空格)
+ */
+const uint8_t *get_ascii_font(char c);
+
+/**
+ * 依碼位取得中文字符的字體資料 (二分搜尋)
+ *
+ * @return 16x16 點陣，字體中沒有此字元時為 NULL
+ */
+const uint8_t *get_chinese_font_cp(uint32_t codepoint);
+
+/**
+ * 取得中文字符的字體資料 (utf8_char 指向一個 UTF-8 字元)
+ */
+const uint8_t *get_chinese_font(const char *utf8_char);
+
+/**
+ * 回報畫面上出現字體中沒有的字元 (同一個字元只記錄一次)
+ * 啟用 CONFIG_EPAPER_FONT_SUBSET 時表示字串清單漏列了這個字
+ */
+void font_report_missing(uint32_t codepoint);
+
+// 碼位是否為全形字元 (16 px 寬)：CJK、諺文、全形符號與 emoji
+static inline bool font_is_wide(uint32_t codepoint) {
+    return (codepoint >= 0x1100 && codepoint <= 0x115F) ||
+           (codepoint >= 0x2E80 && codepoint <= 0xA4CF) ||
+           (codepoint >= 0xAC00 && codepoint <= 0xD7A3) ||
+           (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||
+           (codepoint >= 0xFE30 && codepoint <= 0xFE4F) ||
+           (codepoint >= 0xFF00 && codepoint <= 0xFF60) ||
+           (codepoint >= 0xFFE0 && codepoint <= 0xFFE6) ||
+           (codepoint >= 0x1F300 && codepoint <= 0x1F64F) ||
+           (codepoint >= 0x1F900 && codepoint <= 0x1F9FF) ||
+           (codepoint >= 0x20000 && codepoint <= 0x3FFFD);
+}
+
+#endif // FONT_H
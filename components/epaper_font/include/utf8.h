@@ -0,0 +1,77 @@
+/*
+ * UTF-8 串流解碼
+ *
+ * 從以 '\0' 結尾的字串逐一取出 Unicode 碼位：
+ * - 支援 1~4 位元組序列
+ * - 不合法的序列 (多餘的延續位元組、過長編碼、代理對、超出 U+10FFFF、
+ *   被截斷的序列) 回傳 UTF8_REPLACEMENT，且只跳過已檢查過的位元組，
+ *   下一個字元可以重新同步
+ * - 延續位元組必須是 10xxxxxx，'\0' 不符合，因此不會讀過字串結尾
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-08
+ */
+
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdint.h>
+
+#define UTF8_REPLACEMENT    0xFFFD  // U+FFFD REPLACEMENT CHARACTER
+
+/**
+ * 取出下一個碼位並前進指標
+ *
+ * @param p 指向目前位置的指標；呼叫前 **p 不可為 '\0'
+ * @return 碼位 (不合法時為 UTF8_REPLACEMENT)
+ */
+static inline uint32_t utf8_next(const char **p)
+{
+    const uint8_t *s = (const uint8_t *)*p;
+    uint8_t b0 = s[0];
+
+    // ASCII
+    if (b0 < 0x80) {
+        *p += 1;
+        return b0;
+    }
+
+    uint32_t cp;
+    uint32_t min;
+    int len;
+    if ((b0 & 0xE0) == 0xC0) {
+        cp = b0 & 0x1F;
+        min = 0x80;
+        len = 2;
+    } else if ((b0 & 0xF0) == 0xE0) {
+        cp = b0 & 0x0F;
+        min = 0x800;
+        len = 3;
+    } else if ((b0 & 0xF8) == 0xF0) {
+        cp = b0 & 0x07;
+        min = 0x10000;
+        len = 4;
+    } else {
+        // 單獨的延續位元組或 0xF8~0xFF
+        *p += 1;
+        return UTF8_REPLACEMENT;
+    }
+
+    for (int i = 1; i < len; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            // 序列被截斷 (包含遇到 '\0')：停在這個位元組，下一次從這裡重新解碼
+            *p += i;
+            return UTF8_REPLACEMENT;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+
+    *p += len;
+
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        return UTF8_REPLACEMENT;
+    }
+    return cp;
+}
+
+#endif // UTF8_H
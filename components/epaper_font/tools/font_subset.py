@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+字型子集產生工具：只保留應用程式實際會顯示的中文字，產生編譯進韌體的字形表
+
+字串清單 (manifest) 是 UTF-8 文字檔，列出畫面上所有固定字串；以 '#' 開頭的行為註解。
+清單中每個非 ASCII 字元都會從來源字型 (GNU Unifont .hex) 取出 16x16 點陣，
+輸出依碼位排序的字形表 C 檔，由 font.c 的 get_chinese_font_cp() 二分搜尋。
+
+一般由 component 的 CMakeLists.txt 在編譯時呼叫 (CONFIG_EPAPER_FONT_SUBSET)，也可以手動執行：
+    python font_subset.py unifont.hex font_subset.c strings.txt [more.txt ...]
+"""
+import argparse
+import sys
+
+GLYPH_BYTES = 32                # 16x16
+
+
+def load_manifest(paths):
+    """讀取字串清單，回傳需要的碼位 (只收非 ASCII 字元)"""
+    codepoints = set()
+    for path in paths:
+        with open(path, 'r', encoding='utf-8') as f:
+            for line in f:
+                if line.startswith('#'):
+                    continue
+                codepoints.update(ord(ch) for ch in line if ord(ch) >= 0x80 and not ch.isspace())
+    return codepoints
+
+
+def load_unifont_hex(path, wanted):
+    """從 Unifont .hex 取出需要的字形 (只保留 16x16)"""
+    glyphs = {}
+    narrow = set()
+    with open(path, 'r', encoding='ascii') as f:
+        for line_no, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            try:
+                cp_text, bitmap_hex = line.split(':', 1)
+                codepoint = int(cp_text, 16)
+            except ValueError:
+                sys.exit('{}:{}: invalid line'.format(path, line_no))
+            if codepoint not in wanted:
+                continue
+            if len(bitmap_hex) != GLYPH_BYTES * 2:
+                narrow.add(codepoint)
+                continue
+            glyphs[codepoint] = bytes.fromhex(bitmap_hex)
+    return glyphs, narrow
+
+
+def write_c_source(path, glyphs, manifest_paths):
+    codepoints = sorted(glyphs)
+    lines = [
+        '/*',
+        ' * 字型子集 (由 tools/font_subset.py 自動產生，請勿手動修改)',
+        ' *',
+        ' * 來源清單: {}'.format(', '.join(manifest_paths)),
+        ' * 字數: {}，點陣 {} bytes'.format(len(codepoints), len(codepoints) * GLYPH_BYTES),
+        ' */',
+        '',
+        '#include <stdint.h>',
+        '',
+        'const uint16_t font_subset_count = {};'.format(len(codepoints)),
+        '',
+        '// 依碼位排序的索引',
+        'const uint32_t font_subset_codepoints[] = {',
+    ]
+    for codepoint in codepoints:
+        lines.append('    0x{:04X},  // {}'.format(codepoint, chr(codepoint)))
+    if not codepoints:
+        lines.append('    0')
+    lines += ['};', '', '// 16x16 點陣 (與索引同順序)', 'const uint8_t font_subset_glyphs[][32] = {']
+    for codepoint in codepoints:
+        data = ','.join('0x{:02X}'.format(b) for b in glyphs[codepoint])
+        lines.append('    {{{}}},  // U+{:04X}'.format(data, codepoint))
+    if not codepoints:
+        lines.append('    {0}')
+    lines += ['};', '']
+
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a built-in CJK glyph subset from a string manifest')
+    parser.add_argument('font', help='GNU Unifont .hex file')
+    parser.add_argument('output', help='generated C source')
+    parser.add_argument('manifest', nargs='+', help='UTF-8 text files listing every string the firmware renders')
+    args = parser.parse_args()
+
+    wanted = load_manifest(args.manifest)
+    glyphs, narrow = load_unifont_hex(args.font, wanted)
+
+    missing = sorted(wanted - set(glyphs) - narrow)
+    if missing:
+        print('warning: {} characters not in {}: {}'.format(
+            len(missing), args.font, ''.join(chr(cp) for cp in missing[:20])))
+    if narrow:
+        print('warning: {} narrow (8x16) characters skipped, only ASCII is built in: {}'.format(
+            len(narrow), ''.join(chr(cp) for cp in sorted(narrow)[:20])))
+
+    write_c_source(args.output, glyphs, args.manifest)
+    print('{}: {} glyphs, {} bytes'.format(args.output, len(glyphs), len(glyphs) * (GLYPH_BYTES + 4)))
+
+
+if __name__ == '__main__':
+    main()
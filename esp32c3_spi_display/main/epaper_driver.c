@@ -1,8 +1,8 @@
 /*
  * GDEQ0426T82 E-Paper Display Driver Implementation
  * 
- * 版本: v1.0
- * 日期: 2025-10-27
+ * 版本: v1.1
+ * 日期: 2025-11-19
  */
 
 #include <string.h>
@@ -12,6 +12,7 @@
 #include "esp_log.h"
 #include "epaper_driver.h"
 #include "font.h"
+#include "utf8.h"
 
 static const char *TAG = "EPaper";
 
@@ -541,7 +542,8 @@ void epaper_draw_chinese_16x16(epaper_t *epaper, uint16_t x, uint16_t y, const c
     
     const uint8_t *font_data = get_chinese_font(utf8_char);
     if (font_data == NULL) {
-        ESP_LOGI(TAG, "Chinese char not found");
+        const char *p = utf8_char;
+        font_report_missing(utf8_next(&p));
         return; // 字符不存在
     }
     
@@ -571,25 +573,57 @@ void epaper_draw_chinese_16x16(epaper_t *epaper, uint16_t x, uint16_t y, const c
     }
 }
 
+/**
+ * 逐像素繪製一個 16 px 高的字形 (width 為 8 或 16)，超出螢幕時不繪製
+ */
+static void epaper_draw_glyph_bits(epaper_t *epaper, uint16_t x, uint16_t y, const uint8_t *glyph,
+                                   uint8_t width, uint8_t color)
+{
+    if (x + width > EPAPER_WIDTH || y + 16 > EPAPER_HEIGHT) {
+        return;
+    }
+    
+    uint8_t row_bytes = width / 8;
+    for (int row = 0; row < 16; row++) {
+        for (int col = 0; col < width; col++) {
+            if (glyph[row * row_bytes + col / 8] & (0x80 >> (col % 8))) {
+                epaper_set_pixel(epaper, x + col, y + row, color);
+            }
+        }
+    }
+}
+
 /**
  * 繪製混合字符串 (支持 ASCII 和中文)
+ * 以 utf8_next() 解碼，不合法或被截斷的序列顯示替代字形，不會讀過字串結尾；
+ * 全形字元前進 16 px，其餘 8 px
  */
 void epaper_draw_string(epaper_t *epaper, uint16_t x, uint16_t y, const char *str, uint8_t color)
 {
-    uint16_t cursor_x = x;
+    uint32_t cursor_x = x;
     const char *p = str;
     
-    while (*p != '\0') {
-        if ((uint8_t)*p < 0x80) {
+    while (*p != '\0' && cursor_x < EPAPER_WIDTH) {
+        uint32_t codepoint = utf8_next(&p);
+        
+        if (codepoint < 0x80) {
             // ASCII 字符
-            epaper_draw_char_8x16(epaper, cursor_x, y, *p, color);
+            epaper_draw_char_8x16(epaper, (uint16_t)cursor_x, y, (char)codepoint, color);
             cursor_x += 8;
-            p++;
-        } else {
-            // UTF-8 中文字符 (3 字節)
-            epaper_draw_chinese_16x16(epaper, cursor_x, y, p, color);
+        } else if (font_is_wide(codepoint)) {
+            // 中文等全形字元
+            const uint8_t *font_data = get_chinese_font_cp(codepoint);
+            if (font_data == NULL) {
+                font_report_missing(codepoint);
+                font_data = font_replacement_16x16;
+            }
+            epaper_draw_glyph_bits(epaper, (uint16_t)cursor_x, y, font_data, 16, color);
             cursor_x += 16;
-            p += 3; // 跳過 3 個字節
+        } else {
+            // 沒有 8x16 字形的半形字元 (含 U+FFFD)
+            font_report_missing(codepoint);
+            epaper_draw_glyph_bits(epaper, (uint16_t)cursor_x, y, font_replacement_8x16, 8, color);
+            cursor_x += 8;
         }
     }
 }
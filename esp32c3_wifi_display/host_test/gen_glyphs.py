@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""
+產生解碼基準測試用的合成字形 (Unifont .hex 格式)
+
+以隨機的橫筆、直筆與外框組成接近漢字結構的點陣：上下留白、粗筆畫造成的重複行
+與實際字型相近，逐行 RLE 的壓縮率與解碼時間才有參考價值。結果固定 (固定亂數種子)。
+
+    python gen_glyphs.py size count output.hex
+"""
+import random
+import sys
+
+FIRST = 0x4E00
+
+
+def make_glyph(rng, size):
+    weight = max(1, size // 16)             # 筆畫粗細
+    margin = max(1, size // 16)
+    rows = [[0] * size for _ in range(size)]
+
+    def hline(y, x0, x1):
+        for t in range(weight):
+            if y + t < size:
+                for x in range(x0, x1):
+                    rows[y + t][x] = 1
+
+    def vline(x, y0, y1):
+        for y in range(y0, y1):
+            for t in range(weight):
+                if x + t < size:
+                    rows[y][x + t] = 1
+
+    lo, hi = margin, size - margin - weight
+    for _ in range(rng.randint(2, 5)):
+        x0 = rng.randint(lo, size // 2)
+        hline(rng.randint(lo, hi), x0, rng.randint(x0 + weight, size - margin))
+    for _ in range(rng.randint(1, 4)):
+        y0 = rng.randint(lo, size // 2)
+        vline(rng.randint(lo, hi), y0, rng.randint(y0 + weight, size - margin))
+    if rng.random() < 0.3:
+        # 口字形外框
+        x0, y0 = rng.randint(lo, size // 3), rng.randint(lo, size // 3)
+        x1, y1 = rng.randint(size * 2 // 3, hi), rng.randint(size * 2 // 3, hi)
+        hline(y0, x0, x1 + weight)
+        hline(y1, x0, x1 + weight)
+        vline(x0, y0, y1)
+        vline(x1, y0, y1)
+
+    row_bytes = (size + 7) // 8
+    data = bytearray()
+    for row in rows:
+        value = 0
+        for bit in row + [0] * (row_bytes * 8 - size):
+            value = (value << 1) | bit
+        data += value.to_bytes(row_bytes, 'big')
+    return bytes(data)
+
+
+def main():
+    size, count, output = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3]
+    rng = random.Random(size)
+    with open(output, 'w', encoding='ascii') as f:
+        for i in range(count):
+            f.write('{:04X}:{}\n'.format(FIRST + i, make_glyph(rng, size).hex().upper()))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,12 @@
+/*
+ * 主機端測試用 esp_attr.h
+ */
+
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+#endif // HOST_ESP_ATTR_H
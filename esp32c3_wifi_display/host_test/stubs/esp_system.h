@@ -0,0 +1,19 @@
+/*
+ * 主機端測試用 esp_system.h
+ */
+
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_DEEPSLEEP = 8,
+} esp_reset_reason_t;
+
+esp_reset_reason_t esp_reset_reason(void);
+
+#endif // HOST_ESP_SYSTEM_H
@@ -0,0 +1,12 @@
+/*
+ * 主機端測試用 esp_timer.h (CLOCK_MONOTONIC，微秒)
+ */
+
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // HOST_ESP_TIMER_H
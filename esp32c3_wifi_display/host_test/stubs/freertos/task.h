@@ -0,0 +1,12 @@
+/*
+ * 主機端測試用 task.h (延遲不等待)
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
+
+#endif // HOST_FREERTOS_TASK_H
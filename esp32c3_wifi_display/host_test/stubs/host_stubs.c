@@ -0,0 +1,123 @@
+/*
+ * 主機端測試用 ESP-IDF 函數
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    static char name[16];
+    snprintf(name, sizeof(name), "0x%X", code);
+    return name;
+}
+
+// ============================================
+// 分區
+// ============================================
+
+static esp_partition_t host_partition;
+static uint8_t *host_partition_data = NULL;
+
+esp_err_t host_partition_load(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    free(host_partition_data);
+    host_partition_data = malloc(size);
+    size_t read = fread(host_partition_data, 1, size, f);
+    fclose(f);
+    if (host_partition_data == NULL || read != (size_t)size) {
+        return ESP_FAIL;
+    }
+
+    host_partition.address = 0x200000;
+    host_partition.size = (uint32_t)size;
+    return ESP_OK;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, int subtype, const char *label)
+{
+    return host_partition_data != NULL ? &host_partition : NULL;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out_ptr,
+                             esp_partition_mmap_handle_t *out_handle)
+{
+    if (partition != &host_partition || offset + size > host_partition.size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_ptr = host_partition_data + offset;
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle)
+{
+}
+
+// ============================================
+// 計時、記憶體、重置原因
+// ============================================
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    return malloc(size);
+}
+
+void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
+
+esp_reset_reason_t esp_reset_reason(void)
+{
+    return ESP_RST_POWERON;
+}
+
+// ============================================
+// GPIO 與 SPI (不連接面板)
+// ============================================
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num) { return ESP_OK; }
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) { return ESP_OK; }
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull) { return ESP_OK; }
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) { return ESP_OK; }
+int gpio_get_level(gpio_num_t gpio_num) { return 0; }
+esp_err_t gpio_hold_en(gpio_num_t gpio_num) { return ESP_OK; }
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num) { return ESP_OK; }
+void gpio_deep_sleep_hold_en(void) { }
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan) { return ESP_OK; }
+esp_err_t spi_bus_free(spi_host_device_t host) { return ESP_OK; }
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle) { *handle = NULL; return ESP_OK; }
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) { return ESP_OK; }
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans) { return ESP_OK; }
@@ -0,0 +1,8 @@
+/*
+ * 主機端測試用 sdkconfig.h (只使用內建字型，不產生子集)
+ */
+
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+#endif // HOST_SDKCONFIG_H
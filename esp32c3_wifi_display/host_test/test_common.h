@@ -0,0 +1,78 @@
+/*
+ * 主機端繪圖測試共用函數
+ *
+ * 參考實作直接以面板座標逐像素寫入另一個 framebuffer，
+ * 與 epaper_driver.c 的結果逐 byte 比較。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "epaper_driver.h"
+
+/**
+ * 以 framebuffer 建立只用於繪圖的 epaper_t (不初始化 SPI / GPIO)
+ */
+static inline void test_epaper_init(epaper_t *epaper, uint8_t *framebuffer)
+{
+    memset(epaper, 0, sizeof(*epaper));
+    epaper->framebuffer = framebuffer;
+    epaper_reset_viewport(epaper);
+}
+
+/**
+ * 參考實作：寫入面板座標的單個像素 (面板外忽略)
+ */
+static inline void ref_plot(uint8_t *fb, int32_t x, int32_t y, uint8_t color)
+{
+    if (x < 0 || y < 0 || x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) {
+        return;
+    }
+    uint8_t mask = 0x80 >> (x & 7);
+    uint8_t *p = fb + (uint32_t)y * EPAPER_ROW_BYTES + (x >> 3);
+    *p = (color == COLOR_BLACK) ? (*p & ~mask) : (*p | mask);
+}
+
+/**
+ * 參考實作：讀取面板座標的單個像素 (面板外為白色)
+ */
+static inline uint8_t ref_get(const uint8_t *fb, int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) {
+        return COLOR_WHITE;
+    }
+    return (fb[(uint32_t)y * EPAPER_ROW_BYTES + (x >> 3)] & (0x80 >> (x & 7))) ? COLOR_WHITE : COLOR_BLACK;
+}
+
+/**
+ * 兩個 framebuffer 填入相同的隨機內容
+ */
+static inline void fb_random(uint8_t *a, uint8_t *b)
+{
+    for (int i = 0; i < EPAPER_BUFFER_SIZE; i++) {
+        a[i] = b[i] = (uint8_t)rand();
+    }
+}
+
+static inline uint8_t random_color(void)
+{
+    return (rand() & 1) ? COLOR_BLACK : COLOR_WHITE;
+}
+
+/**
+ * 回報一組比對結果，回傳失敗數
+ */
+static inline int report(const char *name, int failures, int cases)
+{
+    printf("  %-28s %s (%d cases, %d failures)\n", name, failures ? "FAIL" : "ok", cases, failures);
+    return failures;
+}
+
+#endif // TEST_COMMON_H
@@ -0,0 +1,199 @@
+/*
+ * 字型分區 (font_store) 主機端解碼測試與基準測試
+ *
+ * 以 font_packer.py 產生的字型檔作為分區內容 (esp_partition 由 stubs 以檔案模擬)：
+ *   test_font_store image.bin [reference.bin]
+ * - 對每個字型檔的每個字形以 font_store_find + font_store_decode 解碼，
+ *   給定未壓縮的 reference.bin 時逐一比對點陣，並驗證逐行讀取與整個解碼結果相同
+ * - 輸出每種尺寸的平均字形大小與 ns/glyph (原本在開機時量測，改在主機上執行)
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "esp_partition.h"
+#include "font_store.h"
+
+#define BENCH_ROUNDS    20
+
+// 已讀入的字型檔 (直接解析檔案，不經過 font_store)
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} image_t;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int load_image(const char *path, image_t *image)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("FAIL: cannot open %s\n", path);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    image->size = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    image->data = malloc(image->size);
+    size_t read = fread(image->data, 1, image->size, f);
+    fclose(f);
+    return read == image->size ? 0 : 1;
+}
+
+/**
+ * 取得 image 中第 n 個字型檔的標頭 (沒有時回傳 NULL)
+ */
+static const font_store_header_t *image_font(const image_t *image, int n)
+{
+    size_t offset = 0;
+    while (offset + FONT_STORE_HEADER_SIZE <= image->size) {
+        const font_store_header_t *h = (const font_store_header_t *)(image->data + offset);
+        if (h->magic != FONT_STORE_MAGIC) {
+            break;
+        }
+        if (n-- == 0) {
+            return h;
+        }
+        offset += h->file_size;
+    }
+    return NULL;
+}
+
+static const font_store_entry_t *font_index(const font_store_header_t *h)
+{
+    return (const font_store_entry_t *)((const uint8_t *)h + h->index_offset);
+}
+
+/**
+ * 在未壓縮的參考字型中找出碼位的點陣
+ */
+static const uint8_t *reference_glyph(const image_t *ref, uint8_t height, uint32_t codepoint)
+{
+    const font_store_header_t *h;
+    for (int n = 0; (h = image_font(ref, n)) != NULL; n++) {
+        if (h->glyph_height != height || (h->flags & FONT_STORE_FLAG_ROW_RLE)) {
+            continue;
+        }
+        const font_store_entry_t *index = font_index(h);
+        for (uint32_t i = 0; i < h->glyph_count; i++) {
+            if (index[i].codepoint == codepoint) {
+                return (const uint8_t *)h + h->bitmap_offset + index[i].offset;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 驗證一個字型檔的所有字形
+ */
+static int verify_font(const font_store_header_t *h, const image_t *ref)
+{
+    const font_store_entry_t *index = font_index(h);
+    int failures = 0;
+
+    for (uint32_t i = 0; i < h->glyph_count && failures < 10; i++) {
+        uint32_t cp = index[i].codepoint;
+        font_store_glyph_t glyph;
+        uint8_t decoded[FONT_STORE_MAX_GLYPH_BYTES];
+        uint8_t streamed[FONT_STORE_MAX_GLYPH_BYTES];
+
+        if (!font_store_find(h->glyph_height, cp, &glyph) ||
+            font_store_decode(&glyph, decoded, sizeof(decoded)) != ESP_OK) {
+            printf("FAIL: %dpx U+%04X not decoded\n", h->glyph_height, (unsigned)cp);
+            failures++;
+            continue;
+        }
+
+        // 逐行讀取 (繪圖時使用的路徑) 與整個解碼相同
+        font_store_reader_t reader;
+        font_store_reader_init(&reader, &glyph);
+        for (int row = 0; row < glyph.height; row++) {
+            font_store_read_row(&reader, streamed + row * glyph.row_bytes);
+        }
+        size_t glyph_bytes = (size_t)glyph.row_bytes * glyph.height;
+        if (memcmp(decoded, streamed, glyph_bytes) != 0) {
+            printf("FAIL: %dpx U+%04X row reader differs\n", h->glyph_height, (unsigned)cp);
+            failures++;
+        }
+
+        if (ref != NULL) {
+            const uint8_t *expected = reference_glyph(ref, h->glyph_height, cp);
+            if (expected == NULL || memcmp(decoded, expected, glyph_bytes) != 0) {
+                printf("FAIL: %dpx U+%04X differs from reference\n", h->glyph_height, (unsigned)cp);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * 量測一個字型檔所有字形的查詢 + 解碼時間
+ */
+static void bench_font(const font_store_header_t *h)
+{
+    const font_store_entry_t *index = font_index(h);
+    uint8_t buf[FONT_STORE_MAX_GLYPH_BYTES];
+    uint32_t sink = 0;
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < h->glyph_count; i++) {
+            font_store_glyph_t glyph;
+            if (font_store_find(h->glyph_height, index[i].codepoint, &glyph)) {
+                font_store_decode(&glyph, buf, sizeof(buf));
+                sink += buf[glyph.row_bytes * glyph.height / 2];
+            }
+        }
+    }
+    double elapsed = now_ns() - start;
+
+    uint32_t bitmap_bytes = h->file_size - h->bitmap_offset;
+    printf("  %2dx%-2d %s  %6.1f bytes/glyph (raw %d)  %7.1f ns/glyph  (%lu glyphs, sink %lu)\n",
+           h->glyph_width, h->glyph_height, (h->flags & FONT_STORE_FLAG_ROW_RLE) ? "rle" : "raw",
+           (double)bitmap_bytes / h->glyph_count, h->glyph_bytes,
+           elapsed / ((double)h->glyph_count * BENCH_ROUNDS), (unsigned long)h->glyph_count,
+           (unsigned long)sink);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s image.bin [reference.bin]\n", argv[0]);
+        return 2;
+    }
+
+    image_t image, ref;
+    if (load_image(argv[1], &image) != 0 || (argc > 2 && load_image(argv[2], &ref) != 0)) {
+        return 1;
+    }
+    if (host_partition_load(argv[1]) != ESP_OK || font_store_init() != ESP_OK) {
+        printf("FAIL: font_store_init\n");
+        return 1;
+    }
+
+    int failures = 0;
+    const font_store_header_t *h;
+    printf("font_store decode (%s):\n", argv[1]);
+    for (int n = 0; (h = image_font(&image, n)) != NULL; n++) {
+        failures += verify_font(h, argc > 2 ? &ref : NULL);
+        bench_font(h);
+    }
+
+    printf("font_store: %d failures\n", failures);
+    free(image.data);
+    if (argc > 2) {
+        free(ref.data);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * epaper_move_region 與逐像素參考實作的比對與基準測試
+ *
+ *   test_move_region verify [iterations]
+ *   test_move_region bench [rounds]
+ *
+ * 參考實作：來源 S = 區域 ∩ 裁切矩形，先以 fill 填滿 S 中不在 S + (dx, dy) 的像素，
+ * 再把原本的 S 逐像素複製到 S + (dx, dy) ∩ 裁切矩形。
+ * 涵蓋 byte 對齊 / 非對齊位移、原地重疊、移出面板、裁切矩形與 viewport 原點。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include "test_common.h"
+#include "draw_commands.h"
+
+static uint8_t fb_orig[EPAPER_BUFFER_SIZE];
+static uint8_t fb_draw[EPAPER_BUFFER_SIZE];
+static uint8_t fb_ref[EPAPER_BUFFER_SIZE];
+static epaper_t epaper;
+
+static int32_t max32(int32_t a, int32_t b) { return a > b ? a : b; }
+static int32_t min32(int32_t a, int32_t b) { return a < b ? a : b; }
+
+/**
+ * 參考實作 (面板座標的區域 x, y, w, h，裁切到 clip)
+ */
+static void ref_move(uint8_t *fb, const uint8_t *orig, int32_t x, int32_t y, int32_t w, int32_t h,
+                     int32_t dx, int32_t dy, const epaper_rect_t *clip, uint8_t fill)
+{
+    int32_t sx0 = max32(x, clip->x0), sy0 = max32(y, clip->y0);
+    int32_t sx1 = min32(x + w - 1, clip->x1), sy1 = min32(y + h - 1, clip->y1);
+    if (w <= 0 || h <= 0 || sx0 > sx1 || sy0 > sy1 || (dx == 0 && dy == 0)) {
+        return;
+    }
+
+    for (int32_t py = sy0; py <= sy1; py++) {
+        for (int32_t px = sx0; px <= sx1; px++) {
+            bool covered = px - dx >= sx0 && px - dx <= sx1 && py - dy >= sy0 && py - dy <= sy1;
+            if (!covered) {
+                ref_plot(fb, px, py, fill);
+            }
+        }
+    }
+    for (int32_t py = sy0; py <= sy1; py++) {
+        for (int32_t px = sx0; px <= sx1; px++) {
+            int32_t tx = px + dx, ty = py + dy;
+            if (tx >= clip->x0 && tx <= clip->x1 && ty >= clip->y0 && ty <= clip->y1) {
+                ref_plot(fb, tx, ty, ref_get(orig, px, py));
+            }
+        }
+    }
+}
+
+static int verify(int iterations)
+{
+    int bad = 0, bad_view = 0, bad_stream = 0;
+    int failures = 0;
+
+    printf("move_region vs per-pixel reference:\n");
+
+    for (int i = 0; i < iterations; i++) {
+        // 一半的案例裁切到隨機方框；三分之一為大距離位移 (大部分移出)；五分之一 byte 對齊
+        epaper_rect_t clip = { 0, 0, EPAPER_WIDTH - 1, EPAPER_HEIGHT - 1 };
+        int32_t cx = 0, cy = 0, cw = EPAPER_WIDTH, ch = EPAPER_HEIGHT;
+        if (i & 1) {
+            cx = rand() % 600;
+            cy = rand() % 400;
+            cw = 1 + rand() % 400;
+            ch = 1 + rand() % 200;
+            clip.x0 = cx;
+            clip.y0 = cy;
+            clip.x1 = min32(cx + cw - 1, EPAPER_WIDTH - 1);
+            clip.y1 = min32(cy + ch - 1, EPAPER_HEIGHT - 1);
+        }
+        bool near = (i % 3) != 0;
+        int32_t x = rand() % 850, y = rand() % 520, w = rand() % 400, h = rand() % 250;
+        int32_t dx = near ? rand() % 40 - 20 : rand() % 900 - 450;
+        int32_t dy = near ? rand() % 40 - 20 : rand() % 600 - 300;
+        if (i % 5 == 0) {
+            dx = (dx / 8) * 8;
+        }
+        uint8_t fill = random_color();
+
+        for (int k = 0; k < EPAPER_BUFFER_SIZE; k++) {
+            fb_orig[k] = (uint8_t)rand();
+        }
+        memcpy(fb_draw, fb_orig, EPAPER_BUFFER_SIZE);
+        memcpy(fb_ref, fb_orig, EPAPER_BUFFER_SIZE);
+
+        epaper_reset_viewport(&epaper);
+        epaper_push_clip(&epaper, cx, cy, cw, ch);
+        epaper_move_region(&epaper, x, y, w, h, dx, dy, fill);
+        ref_move(fb_ref, fb_orig, x, y, w, h, dx, dy, &clip, fill);
+        bad += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+
+        // viewport 原點：區域座標相對於 (ox, oy)，裁切到 viewport
+        int32_t ox = rand() % 400, oy = rand() % 240;
+        int32_t vw = 1 + rand() % 400, vh = 1 + rand() % 240;
+        epaper_rect_t view = {
+            ox, oy, min32(ox + vw - 1, EPAPER_WIDTH - 1), min32(oy + vh - 1, EPAPER_HEIGHT - 1),
+        };
+        int32_t lx = rand() % 300, ly = rand() % 200;
+        memcpy(fb_draw, fb_orig, EPAPER_BUFFER_SIZE);
+        memcpy(fb_ref, fb_orig, EPAPER_BUFFER_SIZE);
+        epaper_reset_viewport(&epaper);
+        epaper_push_viewport(&epaper, ox, oy, vw, vh);
+        epaper_move_region(&epaper, lx, ly, w, h, dx, dy, fill);
+        ref_move(fb_ref, fb_orig, lx + ox, ly + oy, w, h, dx, dy, &view, fill);
+        bad_view += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+
+        // 繪圖串流的 MOVE 與直接呼叫相同
+        uint8_t ops[] = {
+            DRAW_OP_MOVE,
+            (uint8_t)x, (uint8_t)(x >> 8), (uint8_t)y, (uint8_t)(y >> 8),
+            (uint8_t)w, (uint8_t)(w >> 8), (uint8_t)h, (uint8_t)(h >> 8),
+            (uint8_t)dx, (uint8_t)(dx >> 8), (uint8_t)dy, (uint8_t)(dy >> 8), fill,
+        };
+        draw_bounds_t bounds;
+        memcpy(fb_draw, fb_orig, EPAPER_BUFFER_SIZE);
+        memcpy(fb_ref, fb_orig, EPAPER_BUFFER_SIZE);
+        epaper_reset_viewport(&epaper);
+        if (draw_commands_execute(&epaper, ops, sizeof(ops), &bounds) != ESP_OK) {
+            bad_stream++;
+            continue;
+        }
+        const epaper_rect_t panel = { 0, 0, EPAPER_WIDTH - 1, EPAPER_HEIGHT - 1 };
+        ref_move(fb_ref, fb_orig, x, y, w, h, dx, dy, &panel, fill);
+        bad_stream += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+    }
+    epaper_reset_viewport(&epaper);
+
+    failures += report("clip rectangle", bad, iterations);
+    failures += report("viewport origin", bad_view, iterations);
+    failures += report("MOVE draw op", bad_stream, iterations);
+    printf("move_region: %d failures\n", failures);
+    return failures;
+}
+
+// ============================================
+// 基準測試
+// ============================================
+
+static void bench(int rounds)
+{
+    const epaper_rect_t box = { 10, 40, 789, 439 };
+    int64_t t0, t1;
+
+    printf("move_region 780x400 (%d rounds):\n", rounds);
+
+    // 日誌視窗往上捲一行 (byte 對齊)
+    t0 = esp_timer_get_time();
+    for (int i = 0; i < rounds; i++) {
+        epaper_push_clip(&epaper, 10, 40, 780, 400);
+        epaper_move_region(&epaper, 10, 40, 780, 400, 0, -16, COLOR_WHITE);
+        epaper_pop_viewport(&epaper);
+    }
+    t1 = esp_timer_get_time();
+    printf("  %-24s %9.2f us\n", "scroll up 16 px", (double)(t1 - t0) / rounds);
+
+    // 跑馬燈左移 3 px (非對齊)
+    t0 = esp_timer_get_time();
+    for (int i = 0; i < rounds; i++) {
+        epaper_move_region(&epaper, 10, 40, 780, 400, -3, 0, COLOR_WHITE);
+    }
+    t1 = esp_timer_get_time();
+    printf("  %-24s %9.2f us\n", "shift left 3 px", (double)(t1 - t0) / rounds);
+
+    memcpy(fb_orig, fb_draw, EPAPER_BUFFER_SIZE);
+    t0 = esp_timer_get_time();
+    for (int i = 0; i < rounds; i++) {
+        ref_move(fb_ref, fb_orig, 10, 40, 780, 400, -3, 0, &box, COLOR_WHITE);
+    }
+    t1 = esp_timer_get_time();
+    printf("  %-24s %9.2f us\n", "per-pixel reference", (double)(t1 - t0) / rounds);
+}
+
+int main(int argc, char **argv)
+{
+    int count = (argc > 2) ? atoi(argv[2]) : 0;
+    test_epaper_init(&epaper, fb_draw);
+    srand(50);
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        for (int k = 0; k < EPAPER_BUFFER_SIZE; k++) {
+            fb_draw[k] = (uint8_t)rand();
+        }
+        bench(count > 0 ? count : 500);
+        return 0;
+    }
+    return verify(count > 0 ? count : 3000) ? 1 : 0;
+}
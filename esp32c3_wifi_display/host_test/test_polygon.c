@@ -0,0 +1,173 @@
+/*
+ * 多邊形填滿與逐像素參考實作的比對
+ *
+ *   test_polygon [iterations]
+ *
+ * 參考實作對每個像素中心 (x + 0.5, y + 0.5) 向右發出射線，
+ * 以整數運算計算與每條邊的交點 (奇偶 / 環繞數)，與 epaper_fill_polygon 的結果逐 byte 比較。
+ * 涵蓋自交、超出面板、大量頂點，以及 viewport 位移與裁切矩形。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include "test_common.h"
+
+static uint8_t fb_draw[EPAPER_BUFFER_SIZE];
+static uint8_t fb_ref[EPAPER_BUFFER_SIZE];
+static uint8_t fb_tri[EPAPER_BUFFER_SIZE];
+static epaper_t epaper;
+static epaper_t tri_epaper;
+static epaper_point_t points[EPAPER_POLY_MAX_POINTS];
+
+/**
+ * 參考實作：以 (ox, oy) 為原點，只寫入 clip 內的像素
+ */
+static void ref_polygon(uint8_t *fb, const epaper_point_t *p, int n, epaper_fill_rule_t rule,
+                        int32_t ox, int32_t oy, const epaper_rect_t *clip, uint8_t color)
+{
+    // 只掃描多邊形外接矩形與裁切矩形的交集
+    int32_t bx0 = INT32_MAX, by0 = INT32_MAX, bx1 = INT32_MIN, by1 = INT32_MIN;
+    for (int i = 0; i < n; i++) {
+        bx0 = (p[i].x + ox < bx0) ? p[i].x + ox : bx0;
+        by0 = (p[i].y + oy < by0) ? p[i].y + oy : by0;
+        bx1 = (p[i].x + ox > bx1) ? p[i].x + ox : bx1;
+        by1 = (p[i].y + oy > by1) ? p[i].y + oy : by1;
+    }
+    bx0 = (bx0 < clip->x0) ? clip->x0 : bx0;
+    by0 = (by0 < clip->y0) ? clip->y0 : by0;
+    bx1 = (bx1 > clip->x1) ? clip->x1 : bx1;
+    by1 = (by1 > clip->y1) ? clip->y1 : by1;
+
+    for (int32_t y = by0; y <= by1; y++) {
+        for (int32_t x = bx0; x <= bx1; x++) {
+            int winding = 0;
+            int parity = 0;
+            for (int i = 0; i < n; i++) {
+                int64_t ax = p[i].x + ox, ay = p[i].y + oy;
+                int64_t bx = p[(i + 1) % n].x + ox, by = p[(i + 1) % n].y + oy;
+                int dir = 1;
+                if (ay == by) {
+                    continue;
+                }
+                if (ay > by) {
+                    int64_t t;
+                    t = ax; ax = bx; bx = t;
+                    t = ay; ay = by; by = t;
+                    dir = -1;
+                }
+                if (y < ay || y >= by) {
+                    continue;
+                }
+                // 交點 ax + (y + 0.5 - ay) * (bx - ax) / (by - ay) 在像素中心 x + 0.5 的左側或正上
+                int64_t dy = by - ay;
+                if (2 * ax * dy + (2 * (y - ay) + 1) * (bx - ax) <= (2 * (int64_t)x + 1) * dy) {
+                    winding += dir;
+                    parity ^= 1;
+                }
+            }
+            if (rule == EPAPER_FILL_NONZERO ? (winding != 0) : parity) {
+                ref_plot(fb, x, y, color);
+            }
+        }
+    }
+}
+
+static void random_points(int n, int32_t range)
+{
+    // range 大於面板時頂點會落在面板四周之外
+    for (int i = 0; i < n; i++) {
+        points[i].x = (int16_t)(rand() % range - (range - EPAPER_WIDTH) / 2);
+        points[i].y = (int16_t)(rand() % range - (range - EPAPER_HEIGHT) / 2);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 300;
+    int failures = 0;
+    int bad;
+    const epaper_rect_t panel = { 0, 0, EPAPER_WIDTH - 1, EPAPER_HEIGHT - 1 };
+
+    test_epaper_init(&epaper, fb_draw);
+    test_epaper_init(&tri_epaper, fb_tri);
+    srand(48);
+    printf("polygon fill vs per-pixel reference:\n");
+
+    // 整個面板：小型 / 大型 / 超出面板，兩種填滿規則
+    bad = 0;
+    for (int i = 0; i < iterations; i++) {
+        int n = 3 + rand() % ((i % 10 == 0) ? EPAPER_POLY_MAX_POINTS - 2 : 8);
+        random_points(n, (i % 3) ? 400 : 1200);
+        epaper_fill_rule_t rule = (rand() & 1) ? EPAPER_FILL_NONZERO : EPAPER_FILL_EVEN_ODD;
+        uint8_t color = random_color();
+
+        fb_random(fb_draw, fb_ref);
+        if (epaper_fill_polygon(&epaper, points, n, rule, color) != ESP_OK) {
+            bad++;
+            continue;
+        }
+        ref_polygon(fb_ref, points, n, rule, 0, 0, &panel, color);
+        bad += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+    }
+    failures += report("even-odd / non-zero", bad, iterations);
+
+    // viewport 位移 + 裁切矩形
+    bad = 0;
+    for (int i = 0; i < iterations; i++) {
+        int n = 3 + rand() % 10;
+        random_points(n, 600);
+        epaper_fill_rule_t rule = (rand() & 1) ? EPAPER_FILL_NONZERO : EPAPER_FILL_EVEN_ODD;
+        uint8_t color = random_color();
+        int16_t vx = rand() % 500 - 100, vy = rand() % 300 - 100;
+
+        fb_random(fb_draw, fb_ref);
+        epaper_push_viewport(&epaper, vx, vy, 300 + rand() % 400, 200 + rand() % 300);
+        epaper_push_clip(&epaper, rand() % 200 - 50, rand() % 200 - 50, rand() % 400, rand() % 300);
+        epaper_rect_t clip = epaper.view.clip;
+        epaper_fill_polygon(&epaper, points, n, rule, color);
+        epaper_reset_viewport(&epaper);
+
+        ref_polygon(fb_ref, points, n, rule, vx, vy, &clip, color);
+        bad += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+    }
+    failures += report("viewport + clip", bad, iterations);
+
+    // 扇形三角剖分：相鄰三角形共用的邊不重複繪製，XOR 疊加後等於整個凸多邊形
+    bad = 0;
+    for (int i = 0; i < iterations / 4; i++) {
+        int n = 3 + rand() % 20;
+        int32_t cx = rand() % EPAPER_WIDTH, cy = rand() % EPAPER_HEIGHT, r = 20 + rand() % 300;
+        for (int k = 0; k < n; k++) {
+            double a = 2 * 3.14159265358979 * k / n;
+            points[k].x = (int16_t)(cx + r * cos(a));
+            points[k].y = (int16_t)(cy + r * sin(a));
+        }
+
+        memset(fb_draw, 0xFF, EPAPER_BUFFER_SIZE);
+        memset(fb_ref, 0xFF, EPAPER_BUFFER_SIZE);
+        epaper_fill_polygon(&epaper, points, n, EPAPER_FILL_EVEN_ODD, COLOR_BLACK);
+        for (int k = 1; k + 1 < n; k++) {
+            epaper_point_t tri[3] = { points[0], points[k], points[k + 1] };
+            memset(fb_tri, 0xFF, EPAPER_BUFFER_SIZE);
+            epaper_fill_polygon(&tri_epaper, tri, 3, EPAPER_FILL_EVEN_ODD, COLOR_BLACK);
+            for (int b = 0; b < EPAPER_BUFFER_SIZE; b++) {
+                fb_ref[b] ^= (uint8_t)~fb_tri[b];
+            }
+        }
+        bad += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+    }
+    failures += report("shared edges", bad, iterations / 4);
+
+    // 頂點數檢查
+    bad = 0;
+    bad += epaper_fill_polygon(&epaper, points, 2, EPAPER_FILL_EVEN_ODD, COLOR_BLACK) != ESP_ERR_INVALID_ARG;
+    bad += epaper_fill_polygon(&epaper, points, EPAPER_POLY_MAX_POINTS + 1, EPAPER_FILL_EVEN_ODD, COLOR_BLACK) != ESP_ERR_INVALID_ARG;
+    bad += epaper_fill_polygon(&epaper, NULL, 3, EPAPER_FILL_EVEN_ODD, COLOR_BLACK) != ESP_ERR_INVALID_ARG;
+    failures += report("invalid vertex counts", bad, 3);
+
+    printf("polygon: %d failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * 基本圖形 (span 寫入) 與逐像素參考實作的比對與基準測試
+ *
+ *   test_primitives verify [iterations]
+ *   test_primitives bench [rounds]
+ *
+ * 參考實作以 ref_plot 逐像素寫入，圓形 / 圓角矩形沿用相同的中點圓演算法，
+ * 因此兩者必須逐 byte 相同；圓弧以「兩段互補的圓弧 = 整個圓」驗證。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include "test_common.h"
+
+static uint8_t fb_draw[EPAPER_BUFFER_SIZE];
+static uint8_t fb_ref[EPAPER_BUFFER_SIZE];
+static epaper_t epaper;
+
+// ============================================
+// 逐像素參考實作 (面板座標)
+// ============================================
+
+static void ref_fill_rect(uint8_t *fb, int32_t x, int32_t y, int32_t w, int32_t h, uint8_t color)
+{
+    for (int32_t j = 0; j < h; j++) {
+        for (int32_t i = 0; i < w; i++) {
+            ref_plot(fb, x + i, y + j, color);
+        }
+    }
+}
+
+static void ref_hspan(uint8_t *fb, int32_t x0, int32_t x1, int32_t y, uint8_t color)
+{
+    for (int32_t x = (x0 < x1 ? x0 : x1); x <= (x0 < x1 ? x1 : x0); x++) {
+        ref_plot(fb, x, y, color);
+    }
+}
+
+static void ref_vspan(uint8_t *fb, int32_t x, int32_t y0, int32_t y1, uint8_t color)
+{
+    for (int32_t y = (y0 < y1 ? y0 : y1); y <= (y0 < y1 ? y1 : y0); y++) {
+        ref_plot(fb, x, y, color);
+    }
+}
+
+static void ref_draw_rect(uint8_t *fb, int32_t x, int32_t y, int32_t w, int32_t h, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+    ref_hspan(fb, x, x + w - 1, y, color);
+    ref_hspan(fb, x, x + w - 1, y + h - 1, color);
+    ref_vspan(fb, x, y, y + h - 1, color);
+    ref_vspan(fb, x + w - 1, y, y + h - 1, color);
+}
+
+static void ref_line(uint8_t *fb, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t color)
+{
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = -abs(y1 - y0);
+    int32_t sx = (x0 < x1) ? 1 : -1;
+    int32_t sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx + dy;
+
+    while (1) {
+        ref_plot(fb, x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+/**
+ * 中點圓：outline 時畫八個對稱點，否則以逐像素的水平線填滿
+ * (l, t) (r, b) 為四個角落的圓心，與 epaper_driver.c 相同
+ */
+static void ref_corners(uint8_t *fb, int32_t l, int32_t t, int32_t r, int32_t b,
+                        int32_t radius, bool outline, uint8_t color)
+{
+    int32_t px = radius;
+    int32_t py = 0;
+    int32_t err = 1 - radius;
+
+    while (px >= py) {
+        if (outline) {
+            ref_plot(fb, r + px, t - py, color);
+            ref_plot(fb, r + py, t - px, color);
+            ref_plot(fb, r + px, b + py, color);
+            ref_plot(fb, r + py, b + px, color);
+            ref_plot(fb, l - px, b + py, color);
+            ref_plot(fb, l - py, b + px, color);
+            ref_plot(fb, l - px, t - py, color);
+            ref_plot(fb, l - py, t - px, color);
+        } else {
+            ref_hspan(fb, l - px, r + px, t - py, color);
+            ref_hspan(fb, l - px, r + px, b + py, color);
+            ref_hspan(fb, l - py, r + py, t - px, color);
+            ref_hspan(fb, l - py, r + py, b + px, color);
+        }
+
+        py++;
+        if (err < 0) {
+            err += 2 * py + 1;
+        } else {
+            px--;
+            err += 2 * (py - px) + 1;
+        }
+    }
+}
+
+static int32_t ref_radius(int32_t w, int32_t h, int32_t r)
+{
+    int32_t max_r = ((w < h) ? w : h) / 2;
+    return (r > max_r) ? max_r : r;
+}
+
+static void ref_round_rect(uint8_t *fb, int32_t x, int32_t y, int32_t w, int32_t h, int32_t r,
+                           bool outline, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+    r = ref_radius(w, h, r);
+    int32_t x1 = x + w - 1;
+    int32_t y1 = y + h - 1;
+
+    if (outline) {
+        if (r == 0) {
+            ref_draw_rect(fb, x, y, w, h, color);
+            return;
+        }
+        ref_hspan(fb, x + r, x1 - r, y, color);
+        ref_hspan(fb, x + r, x1 - r, y1, color);
+        ref_vspan(fb, x, y + r, y1 - r, color);
+        ref_vspan(fb, x1, y + r, y1 - r, color);
+    } else {
+        ref_fill_rect(fb, x, y + r, w, h - 2 * r, color);
+        if (r == 0) {
+            return;
+        }
+    }
+    ref_corners(fb, x + r, y + r, x1 - r, y1 - r, r, outline, color);
+}
+
+// ============================================
+// 比對
+// ============================================
+
+static bool same(void)
+{
+    return memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) == 0;
+}
+
+static int verify(int iterations)
+{
+    int failures = 0;
+    int bad;
+
+    printf("primitives vs per-pixel reference:\n");
+
+    // 矩形與水平 / 垂直線：超出面板的部分裁切
+    bad = 0;
+    for (int i = 0; i < iterations; i++) {
+        int32_t x = rand() % 900, y = rand() % 560, w = rand() % 300, h = rand() % 200;
+        uint8_t color = random_color();
+        fb_random(fb_draw, fb_ref);
+        epaper_fill_rect(&epaper, x, y, w, h, color);
+        ref_fill_rect(fb_ref, x, y, w, h, color);
+        epaper_draw_rect(&epaper, x + 3, y + 5, w, h, color ^ 0xFF);
+        ref_draw_rect(fb_ref, x + 3, y + 5, w, h, color ^ 0xFF);
+        bad += !same();
+    }
+    failures += report("fill_rect / draw_rect", bad, iterations);
+
+    bad = 0;
+    for (int i = 0; i < iterations; i++) {
+        int32_t x = rand() % 900, y = rand() % 560, len = rand() % 900;
+        uint8_t color = random_color();
+        fb_random(fb_draw, fb_ref);
+        epaper_draw_hline(&epaper, x, y, len, color);
+        epaper_draw_vline(&epaper, y, x % EPAPER_HEIGHT, len, color);
+        if (len > 0) {
+            ref_hspan(fb_ref, x, x + len - 1, y, color);
+            ref_vspan(fb_ref, y, x % EPAPER_HEIGHT, x % EPAPER_HEIGHT + len - 1, color);
+        }
+        bad += !same();
+    }
+    failures += report("hline / vline", bad, iterations);
+
+    // 直線：起點在面板內 (uint16_t 參數)，終點可在面板外
+    bad = 0;
+    for (int i = 0; i < iterations; i++) {
+        int32_t x0 = rand() % EPAPER_WIDTH, y0 = rand() % EPAPER_HEIGHT;
+        int32_t x1 = rand() % 1000, y1 = rand() % 700;
+        if (i % 4 == 0) {
+            y1 = y0;
+        } else if (i % 4 == 1) {
+            x1 = x0;
+        }
+        uint8_t color = random_color();
+        fb_random(fb_draw, fb_ref);
+        epaper_draw_line(&epaper, x0, y0, x1, y1, color);
+        ref_line(fb_ref, x0, y0, x1, y1, color);
+        bad += !same();
+    }
+    failures += report("draw_line", bad, iterations);
+
+    // 圓形與圓弧 (可部分超出面板)
+    bad = 0;
+    int circles = iterations / 4;
+    for (int i = 0; i < circles; i++) {
+        int32_t cx = rand() % 900, cy = rand() % 560, r = rand() % 250;
+        uint8_t color = random_color();
+        fb_random(fb_draw, fb_ref);
+        epaper_fill_circle(&epaper, cx, cy, r, color);
+        ref_corners(fb_ref, cx, cy, cx, cy, r, false, color);
+        epaper_draw_circle(&epaper, cx, cy, r + 7, color ^ 0xFF);
+        ref_corners(fb_ref, cx, cy, cx, cy, r + 7, true, color ^ 0xFF);
+        bad += !same();
+
+        // arc(a, b) + arc(b, a) = 整個圓
+        int16_t a = rand() % 361, b = rand() % 361;
+        if (a == b) {
+            continue;
+        }
+        memset(fb_draw, 0xFF, EPAPER_BUFFER_SIZE);
+        memset(fb_ref, 0xFF, EPAPER_BUFFER_SIZE);
+        epaper_draw_arc(&epaper, cx, cy, r, a, b, COLOR_BLACK);
+        epaper_draw_arc(&epaper, cx, cy, r, b, a, COLOR_BLACK);
+        ref_corners(fb_ref, cx, cy, cx, cy, r, true, COLOR_BLACK);
+        bad += !same();
+    }
+    failures += report("circle / arc", bad, circles);
+
+    bad = 0;
+    for (int i = 0; i < circles; i++) {
+        int32_t x = rand() % 900, y = rand() % 560, w = rand() % 300, h = rand() % 200, r = rand() % 80;
+        uint8_t color = random_color();
+        fb_random(fb_draw, fb_ref);
+        epaper_fill_round_rect(&epaper, x, y, w, h, r, color);
+        ref_round_rect(fb_ref, x, y, w, h, r, false, color);
+        epaper_draw_round_rect(&epaper, x + 2, y + 1, w, h, r, color ^ 0xFF);
+        ref_round_rect(fb_ref, x + 2, y + 1, w, h, r, true, color ^ 0xFF);
+        bad += !same();
+    }
+    failures += report("round_rect", bad, circles);
+
+    printf("primitives: %d failures\n", failures);
+    return failures;
+}
+
+// ============================================
+// 基準測試
+// ============================================
+
+#define BENCH(label, rounds, fast, slow) do {                                   \
+        int64_t t0 = esp_timer_get_time();                                      \
+        for (int i = 0; i < (rounds); i++) { fast; }                            \
+        int64_t t1 = esp_timer_get_time();                                      \
+        for (int i = 0; i < (rounds); i++) { slow; }                            \
+        int64_t t2 = esp_timer_get_time();                                      \
+        printf("  %-24s %9.2f us   per-pixel %9.2f us   (%.0fx)\n", label,     \
+               (double)(t1 - t0) / (rounds), (double)(t2 - t1) / (rounds),      \
+               (double)(t2 - t1) / (double)((t1 - t0) ? (t1 - t0) : 1));        \
+    } while (0)
+
+#define BENCH_COLOR(i)  (((i) & 1) ? COLOR_BLACK : COLOR_WHITE)
+
+static void grid(uint8_t color)
+{
+    for (uint16_t x = 0; x < EPAPER_WIDTH; x += 50) {
+        epaper_draw_vline(&epaper, x, 0, EPAPER_HEIGHT, color);
+    }
+    for (uint16_t y = 0; y < EPAPER_HEIGHT; y += 50) {
+        epaper_draw_hline(&epaper, 0, y, EPAPER_WIDTH, color);
+    }
+}
+
+static void ref_grid(uint8_t color)
+{
+    for (int32_t x = 0; x < EPAPER_WIDTH; x += 50) {
+        ref_vspan(fb_draw, x, 0, EPAPER_HEIGHT - 1, color);
+    }
+    for (int32_t y = 0; y < EPAPER_HEIGHT; y += 50) {
+        ref_hspan(fb_draw, 0, EPAPER_WIDTH - 1, y, color);
+    }
+}
+
+static void bench(int rounds)
+{
+    printf("primitives (%d rounds):\n", rounds);
+    BENCH("fill_rect 600x300", rounds,
+          epaper_fill_rect(&epaper, 13, 7, 600, 300, BENCH_COLOR(i)),
+          ref_fill_rect(fb_draw, 13, 7, 600, 300, BENCH_COLOR(i)));
+    BENCH("draw_rect 600x300", rounds,
+          epaper_draw_rect(&epaper, 13, 7, 600, 300, BENCH_COLOR(i)),
+          ref_draw_rect(fb_draw, 13, 7, 600, 300, BENCH_COLOR(i)));
+    BENCH("grid 50 px", rounds, grid(BENCH_COLOR(i)), ref_grid(BENCH_COLOR(i)));
+    BENCH("draw_line 794x466", rounds,
+          epaper_draw_line(&epaper, 3, 5, 797, 471, BENCH_COLOR(i)),
+          ref_line(fb_draw, 3, 5, 797, 471, BENCH_COLOR(i)));
+    BENCH("fill_circle r=200", rounds,
+          epaper_fill_circle(&epaper, 400, 240, 200, BENCH_COLOR(i)),
+          ref_corners(fb_draw, 400, 240, 400, 240, 200, false, BENCH_COLOR(i)));
+    BENCH("fill_round_rect r=40", rounds,
+          epaper_fill_round_rect(&epaper, 50, 50, 700, 380, 40, BENCH_COLOR(i)),
+          ref_round_rect(fb_draw, 50, 50, 700, 380, 40, false, BENCH_COLOR(i)));
+}
+
+int main(int argc, char **argv)
+{
+    int count = (argc > 2) ? atoi(argv[2]) : 0;
+    test_epaper_init(&epaper, fb_draw);
+    srand(47);
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        bench(count > 0 ? count : 200);
+        return 0;
+    }
+    return verify(count > 0 ? count : 2000) ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * 文字點陣快取：LRU / 預算計算與快取前後的繪製結果比對
+ *
+ *   test_text_cache
+ *
+ * 直接呼叫 text_cache API 檢查項目數上限、bytes 預算與 LRU 淘汰順序；
+ * 再以 epaper_draw_string(_scaled) 繪製同一字串三次 (第一次逐字繪製、第二次渲染進快取、
+ * 第三次命中快取)，三個 framebuffer 必須逐 byte 相同。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "text_cache.h"
+
+static uint8_t fb_base[EPAPER_BUFFER_SIZE];
+static uint8_t fb_pass[3][EPAPER_BUFFER_SIZE];
+static epaper_t epaper;
+
+static bool cached(const char *str)
+{
+    uint16_t w, h;
+    return text_cache_lookup(TEXT_CACHE_FONT_16, str, &w, &h) != NULL;
+}
+
+/**
+ * 項目數上限與 LRU：超過 TEXT_CACHE_MAX_ENTRIES 時淘汰最久未使用的項目
+ */
+static int check_entries(void)
+{
+    int bad = 0;
+    char key[8];
+    text_cache_stats_t st;
+
+    text_cache_clear();
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+        snprintf(key, sizeof(key), "e%d", i);
+        bad += text_cache_alloc(TEXT_CACHE_FONT_16, key, 16, 16) == NULL;
+    }
+    text_cache_get_stats(&st);
+    bad += st.entries != TEXT_CACHE_MAX_ENTRIES || st.evictions != 0;
+
+    // 使用 e0 之後再配置兩個：淘汰的是 e1、e2
+    bad += !cached("e0");
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "x0", 16, 16) == NULL;
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "x1", 16, 16) == NULL;
+    text_cache_get_stats(&st);
+    bad += st.entries != TEXT_CACHE_MAX_ENTRIES || st.evictions != 2;
+    bad += !cached("e0") || cached("e1") || cached("e2") || !cached("e3");
+    bad += !cached("x0") || !cached("x1");
+
+    return report("entry limit / LRU", bad, TEXT_CACHE_MAX_ENTRIES + 2);
+}
+
+/**
+ * bytes 預算：用量等於現存項目的總和且不超過 TEXT_CACHE_BUDGET
+ */
+static int check_budget(void)
+{
+    int bad = 0;
+    text_cache_stats_t st;
+
+    text_cache_clear();
+    text_cache_get_stats(&st);
+    bad += st.entries != 0 || st.bytes != 0;
+
+    // 一個 800 x 16 的點陣 1600 bytes：預算內放得下三個
+    uint32_t evictions = st.evictions;
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "b0", EPAPER_WIDTH, 16) == NULL;
+    text_cache_get_stats(&st);
+    uint32_t entry_bytes = st.bytes;
+    bad += entry_bytes < EPAPER_WIDTH / 8 * 16;
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "b1", EPAPER_WIDTH, 16) == NULL;
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "b2", EPAPER_WIDTH, 16) == NULL;
+    text_cache_get_stats(&st);
+    bad += st.entries != 3 || st.bytes != 3 * entry_bytes || st.evictions != evictions;
+
+    // 使用 b0 後第四個項目淘汰 b1
+    bad += !cached("b0");
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "b3", EPAPER_WIDTH, 16) == NULL;
+    text_cache_get_stats(&st);
+    bad += st.bytes > TEXT_CACHE_BUDGET || st.bytes != st.entries * entry_bytes;
+    bad += st.evictions != evictions + 1;
+    bad += !cached("b0") || cached("b1") || !cached("b2") || !cached("b3");
+
+    // 超過預算的點陣與過長的字串不快取，也不淘汰現有項目
+    char long_str[TEXT_CACHE_MAX_LEN + 2];
+    memset(long_str, 'a', sizeof(long_str) - 1);
+    long_str[sizeof(long_str) - 1] = '\0';
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "big", EPAPER_WIDTH, 64) != NULL;
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, long_str, 16, 16) != NULL;
+    bad += text_cache_admit(TEXT_CACHE_FONT_16, long_str);
+    text_cache_get_stats(&st);
+    bad += st.entries != 3 || st.evictions != evictions + 1;
+
+    // 重新配置同一字串會取代舊項目，不會重複計算
+    bad += text_cache_alloc(TEXT_CACHE_FONT_16, "b0", EPAPER_WIDTH, 16) == NULL;
+    text_cache_get_stats(&st);
+    bad += st.entries != 3 || st.bytes != 3 * entry_bytes;
+
+    text_cache_clear();
+    text_cache_get_stats(&st);
+    bad += st.entries != 0 || st.bytes != 0;
+
+    return report("byte budget", bad, 5);
+}
+
+/**
+ * 第二次使用才放入快取
+ */
+static int check_admission(void)
+{
+    int bad = 0;
+    text_cache_stats_t st;
+
+    text_cache_clear();
+    text_cache_get_stats(&st);
+    uint32_t deferred = st.deferred;
+    bad += text_cache_admit(TEXT_CACHE_FONT_16, "label");
+    bad += !text_cache_admit(TEXT_CACHE_FONT_16, "label");
+    bad += text_cache_admit(TEXT_CACHE_FONT_16, "label");   // 同意後記錄被取走
+    text_cache_get_stats(&st);
+    bad += st.deferred != deferred + 2;
+
+    // 只記住最近 TEXT_CACHE_SEEN_SLOTS 個字串
+    char key[8];
+    text_cache_clear();
+    for (int i = 0; i <= TEXT_CACHE_SEEN_SLOTS; i++) {
+        snprintf(key, sizeof(key), "s%d", i);
+        bad += text_cache_admit(TEXT_CACHE_FONT_16, key);
+    }
+    bad += text_cache_admit(TEXT_CACHE_FONT_16, "s0");
+    bad += !text_cache_admit(TEXT_CACHE_FONT_16, "s2");
+
+    // epaper_draw_string：第一次不配置，第二次放入，第三次命中
+    text_cache_clear();
+    test_epaper_init(&epaper, fb_pass[0]);
+    text_cache_get_stats(&st);
+    uint32_t hits = st.hits;
+    for (int pass = 0; pass < 3; pass++) {
+        epaper_draw_string(&epaper, 10, 10, "Humidity", COLOR_BLACK);
+        text_cache_get_stats(&st);
+        bad += st.entries != (pass == 0 ? 0 : 1);
+        bad += st.hits != hits + (pass == 2 ? 1 : 0);
+    }
+
+    return report("second-use admission", bad, 3 + TEXT_CACHE_SEEN_SLOTS + 3);
+}
+
+/**
+ * 繪製三次 (逐字 / 渲染進快取 / 命中快取) 的結果必須相同
+ */
+static int check_output(int iterations)
+{
+    static const char *strings[] = {
+        "Temp 23.5",
+        "中文 OK",
+        "km/h",
+        "\xE4\xB8",             // 截斷的 UTF-8 序列
+        "A\x80" "B\xFF" "C",    // 不合法的 byte
+        "\xF0\x9F\x98\x80 x",   // 字型中沒有的字元
+        "0123456789012345678901234567890123456789012345678901234",  // 超過 TEXT_CACHE_MAX_LEN
+    };
+    const int count = sizeof(strings) / sizeof(strings[0]);
+    int bad = 0;
+
+    for (int it = 0; it < iterations; it++) {
+        const char *str = strings[it % count];
+        uint8_t scale = (it & 4) ? 1 + rand() % 3 : 1;
+        uint8_t color = random_color();
+        uint16_t x = rand() % (EPAPER_WIDTH + 32);
+        uint16_t y = rand() % (EPAPER_HEIGHT + 32);
+        // viewport 原點可為負，字串可能只有中間一段可見
+        bool viewport = rand() & 1;
+        int16_t vx = rand() % 500 - 200, vy = rand() % 300 - 100;
+        uint16_t vw = 1 + rand() % 400, vh = 1 + rand() % 240;
+
+        for (int i = 0; i < EPAPER_BUFFER_SIZE; i++) {
+            fb_base[i] = (uint8_t)rand();
+        }
+
+        text_cache_clear();
+        for (int pass = 0; pass < 3; pass++) {
+            memcpy(fb_pass[pass], fb_base, EPAPER_BUFFER_SIZE);
+            test_epaper_init(&epaper, fb_pass[pass]);
+            if (viewport) {
+                epaper_push_viewport(&epaper, vx, vy, vw, vh);
+            }
+            epaper_draw_string_scaled(&epaper, x, y, str, scale, color);
+        }
+
+        int diff = memcmp(fb_pass[0], fb_pass[1], EPAPER_BUFFER_SIZE) != 0 ||
+                   memcmp(fb_pass[0], fb_pass[2], EPAPER_BUFFER_SIZE) != 0;
+        if (diff && bad < 5) {
+            printf("    mismatch: \"%s\" at (%d, %d) scale %d%s\n",
+                   str, x, y, scale, viewport ? " in viewport" : "");
+        }
+        bad += diff;
+    }
+
+    return report("cached == uncached output", bad, iterations);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 500;
+    srand(7);
+
+    printf("text cache (budget %d bytes, %d entries, %d seen slots):\n",
+           TEXT_CACHE_BUDGET, TEXT_CACHE_MAX_ENTRIES, TEXT_CACHE_SEEN_SLOTS);
+    int failures = 0;
+    failures += check_entries();
+    failures += check_budget();
+    failures += check_admission();
+    failures += check_output(iterations);
+    text_cache_clear();
+
+    printf("text cache: %d failures\n", failures);
+    return failures ? 1 : 0;
+}
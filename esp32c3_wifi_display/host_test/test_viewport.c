@@ -0,0 +1,268 @@
+/*
+ * viewport / 裁切堆疊與逐像素參考實作的比對
+ *
+ *   test_viewport [iterations]
+ *
+ * 每個案例 push 一層 viewport 再 push 一層裁切矩形 (部分超出面板、可為空)，
+ * 以區域座標繪製後，與「不使用 viewport、以面板座標繪製再只保留裁切矩形內的像素」比較。
+ * 點陣圖另以逐像素的放大參考實作比對，並涵蓋負的 viewport 原點。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-19
+ */
+
+#include "test_common.h"
+#include "draw_commands.h"
+
+static uint8_t fb_orig[EPAPER_BUFFER_SIZE];
+static uint8_t fb_draw[EPAPER_BUFFER_SIZE];
+static uint8_t fb_ref[EPAPER_BUFFER_SIZE];
+static uint8_t fb_screen[EPAPER_BUFFER_SIZE];
+static epaper_t epaper;
+static epaper_t screen;
+
+// 一個案例的參數 (區域座標)
+typedef struct {
+    int32_t x, y, w, h, r;
+    uint8_t color;
+    epaper_point_t poly[5];
+} case_t;
+
+// (ox, oy) 為 0 時以區域座標繪製，否則以面板座標繪製
+typedef void (*draw_fn)(epaper_t *e, int32_t ox, int32_t oy, const case_t *c);
+
+static void draw_rects(epaper_t *e, int32_t ox, int32_t oy, const case_t *c)
+{
+    epaper_fill_rect(e, c->x + ox, c->y + oy, c->w, c->h, c->color);
+    epaper_draw_rect(e, c->x + ox + 4, c->y + oy + 4, c->w, c->h, c->color ^ 0xFF);
+}
+
+static void draw_lines(epaper_t *e, int32_t ox, int32_t oy, const case_t *c)
+{
+    epaper_draw_line(e, c->x + ox, c->y + oy, c->w + ox, c->h + oy, c->color);
+    epaper_set_pixel(e, c->x + ox, c->y + oy + 3, c->color);
+    epaper_draw_hline(e, c->x + ox, c->y + oy + 1, c->w, c->color);
+    epaper_draw_vline(e, c->x + ox + 2, c->y + oy, c->h, c->color);
+}
+
+static void draw_circles(epaper_t *e, int32_t ox, int32_t oy, const case_t *c)
+{
+    epaper_fill_circle(e, c->x + ox, c->y + oy, c->r, c->color);
+    epaper_draw_arc(e, c->x + ox, c->y + oy, c->r + 5, 30, 250, c->color);
+    epaper_fill_round_rect(e, c->x + ox, c->y + oy, c->w, c->h, c->r, c->color);
+    epaper_draw_round_rect(e, c->x + ox, c->y + oy, c->w, c->h, c->r, c->color ^ 0xFF);
+}
+
+static void draw_polygons(epaper_t *e, int32_t ox, int32_t oy, const case_t *c)
+{
+    epaper_point_t p[5];
+    for (int i = 0; i < 5; i++) {
+        p[i].x = (int16_t)(c->poly[i].x + ox);
+        p[i].y = (int16_t)(c->poly[i].y + oy);
+    }
+    epaper_fill_polygon(e, p, 5, EPAPER_FILL_NONZERO, c->color);
+    epaper_draw_polygon(e, p, 5, true, c->color ^ 0xFF);
+}
+
+static void draw_text(epaper_t *e, int32_t ox, int32_t oy, const case_t *c)
+{
+    epaper_draw_string(e, c->x + ox, c->y + oy, "Hi 中文 clip", c->color);
+    epaper_draw_string_scaled(e, c->x + ox, c->y + oy + 20, "12:45", 3, c->color);
+}
+
+static const struct {
+    const char *name;
+    draw_fn draw;
+} cases[] = {
+    { "fill_rect / draw_rect", draw_rects },
+    { "line / pixel / hline / vline", draw_lines },
+    { "circle / arc / round_rect", draw_circles },
+    { "polygon fill / outline", draw_polygons },
+    { "string / scaled string", draw_text },
+};
+#define CASE_COUNT  (sizeof(cases) / sizeof(cases[0]))
+
+/**
+ * 參考實作：放大 scale 倍的點陣圖，只寫入 clip 內的像素
+ */
+static void ref_bitmap(uint8_t *fb, int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h,
+                       int32_t scale, const epaper_rect_t *clip, uint8_t color)
+{
+    int32_t stride = (w + 7) / 8;
+    for (int32_t row = 0; row < h * scale; row++) {
+        for (int32_t col = 0; col < w * scale; col++) {
+            int32_t sx = col / scale, sy = row / scale;
+            int32_t px = x + col, py = y + row;
+            if (!(bitmap[sy * stride + sx / 8] & (0x80 >> (sx % 8))) ||
+                px < clip->x0 || px > clip->x1 || py < clip->y0 || py > clip->y1) {
+                continue;
+            }
+            ref_plot(fb, px, py, color);
+        }
+    }
+}
+
+/**
+ * fb_ref = fb_orig，只有 clip 內的像素取自 fb_screen
+ */
+static void ref_masked(const epaper_rect_t *clip)
+{
+    memcpy(fb_ref, fb_orig, EPAPER_BUFFER_SIZE);
+    for (int32_t y = clip->y0; y <= clip->y1; y++) {
+        for (int32_t x = clip->x0; x <= clip->x1; x++) {
+            ref_plot(fb_ref, x, y, ref_get(fb_screen, x, y));
+        }
+    }
+}
+
+static int32_t max32(int32_t a, int32_t b) { return a > b ? a : b; }
+static int32_t min32(int32_t a, int32_t b) { return a < b ? a : b; }
+
+static int check_stack(void)
+{
+    int bad = 0;
+
+    // EPAPER_VIEW_DEPTH 層之後拒絕，pop 回到整個面板
+    epaper_reset_viewport(&epaper);
+    for (int i = 0; i < EPAPER_VIEW_DEPTH; i++) {
+        bad += epaper_push_viewport(&epaper, 1, 1, 100, 100) != ESP_OK;
+    }
+    bad += epaper_push_viewport(&epaper, 0, 0, 1, 1) != ESP_ERR_NO_MEM;
+    bad += epaper.view.ox != EPAPER_VIEW_DEPTH;
+    for (int i = 0; i < EPAPER_VIEW_DEPTH; i++) {
+        epaper_pop_viewport(&epaper);
+    }
+    bad += epaper.view.ox != 0 || epaper.view.clip.x1 != EPAPER_WIDTH - 1 ||
+           epaper.view.clip.y1 != EPAPER_HEIGHT - 1;
+    epaper_pop_viewport(&epaper);   // 多的 pop 忽略
+    bad += epaper.view_depth != 0;
+
+    // 繪圖串流：viewport 內的矩形裁切到 viewport，受影響範圍也只包含 viewport
+    uint8_t ops[] = {
+        DRAW_OP_VIEWPORT, 100, 0, 50, 0, 40, 0, 30, 0,
+        DRAW_OP_FILL_RECT, 0, 0, 0, 0, 200, 0, 200, 0, COLOR_BLACK,
+        DRAW_OP_VIEWPORT_POP,
+    };
+    draw_bounds_t bounds;
+    memset(fb_draw, 0xFF, EPAPER_BUFFER_SIZE);
+    bad += draw_commands_execute(&epaper, ops, sizeof(ops), &bounds) != ESP_OK;
+    bad += bounds.x0 != 100 || bounds.y0 != 50 || bounds.x1 != 139 || bounds.y1 != 79;
+    bad += epaper.view_depth != 0;
+    memset(fb_ref, 0xFF, EPAPER_BUFFER_SIZE);
+    for (int32_t y = 50; y < 80; y++) {
+        for (int32_t x = 100; x < 140; x++) {
+            ref_plot(fb_ref, x, y, COLOR_BLACK);
+        }
+    }
+    bad += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+
+    // 串流結束時未 pop 的 viewport 自動關閉；沒有 push 的 pop 是錯誤
+    uint8_t unclosed[] = { DRAW_OP_VIEWPORT, 100, 0, 50, 0, 40, 0, 30, 0, DRAW_OP_CLEAR, COLOR_WHITE };
+    bad += draw_commands_execute(&epaper, unclosed, sizeof(unclosed), &bounds) != ESP_OK;
+    bad += epaper.view_depth != 0;
+    uint8_t stray_pop[] = { DRAW_OP_VIEWPORT_POP };
+    bad += draw_commands_execute(&epaper, stray_pop, sizeof(stray_pop), &bounds) == ESP_OK;
+
+    // 跨距 65535 的線段：受影響範圍不可因 16 位元溢位而變成空的
+    uint8_t wide_line[] = { DRAW_OP_LINE, 0, 0, 10, 0, 0xFF, 0xFF, 10, 0, COLOR_BLACK };
+    bad += draw_commands_execute(&epaper, wide_line, sizeof(wide_line), &bounds) != ESP_OK;
+    bad += !bounds.valid || bounds.x0 != 0 || bounds.x1 != EPAPER_WIDTH - 1 ||
+           bounds.y0 != 10 || bounds.y1 != 10;
+
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    int bad_clip = 0, bad_bitmap = 0, bad_case[CASE_COUNT] = { 0 };
+    int failures = 0;
+    uint8_t bitmap[5 * 20];
+
+    test_epaper_init(&epaper, fb_draw);
+    test_epaper_init(&screen, fb_screen);
+    srand(49);
+    printf("viewport / clip vs per-pixel reference:\n");
+
+    for (int i = 0; i < iterations; i++) {
+        // 奇數案例的原點可為負 (只用有號參數的點陣圖驗證)
+        bool negative = i & 1;
+        int32_t ox = negative ? rand() % 900 - 150 : rand() % 600;
+        int32_t oy = negative ? rand() % 600 - 150 : rand() % 350;
+        int32_t vw = 1 + rand() % 500, vh = 1 + rand() % 300;
+        int32_t cx = rand() % 200 - 50, cy = rand() % 200 - 50, cw = rand() % 300, ch = rand() % 200;
+
+        // 預期的裁切矩形 (面板座標，含兩端)
+        epaper_rect_t expect = {
+            .x0 = max32(0, max32(ox, ox + cx)),
+            .y0 = max32(0, max32(oy, oy + cy)),
+            .x1 = min32(EPAPER_WIDTH - 1, min32(ox + vw - 1, ox + cx + cw - 1)),
+            .y1 = min32(EPAPER_HEIGHT - 1, min32(oy + vh - 1, oy + cy + ch - 1)),
+        };
+        bool visible = cw > 0 && ch > 0 && expect.x0 <= expect.x1 && expect.y0 <= expect.y1;
+        if (!visible) {
+            expect.x1 = expect.x0 - 1;
+        }
+
+        epaper_reset_viewport(&epaper);
+        epaper_push_viewport(&epaper, ox, oy, vw, vh);
+        epaper_push_clip(&epaper, cx, cy, cw, ch);
+
+        epaper_rect_t got;
+        bool ok = epaper_clip_rect(&epaper, -1000, -1000, 5000, 5000, &got);
+        if (ok != visible || (ok && memcmp(&got, &expect, sizeof(got)) != 0)) {
+            bad_clip++;
+        }
+
+        case_t c = {
+            .x = rand() % 400, .y = rand() % 300, .w = 1 + rand() % 300, .h = 1 + rand() % 200,
+            .r = rand() % 60, .color = random_color(),
+        };
+        for (int k = 0; k < 5; k++) {
+            c.poly[k].x = (int16_t)(rand() % 400 - 50);
+            c.poly[k].y = (int16_t)(rand() % 300 - 50);
+        }
+        for (int k = 0; k < (int)sizeof(bitmap); k++) {
+            bitmap[k] = (uint8_t)rand();
+        }
+        for (int k = 0; k < EPAPER_BUFFER_SIZE; k++) {
+            fb_orig[k] = (uint8_t)rand();
+        }
+
+        // 點陣圖 (1x 與放大)，可從負座標開始
+        int32_t bw = 1 + rand() % 40, bh = 1 + rand() % 20, scale = 1 + rand() % 5;
+        memcpy(fb_draw, fb_orig, EPAPER_BUFFER_SIZE);
+        memcpy(fb_ref, fb_orig, EPAPER_BUFFER_SIZE);
+        epaper_draw_bitmap(&epaper, c.x, c.y, bitmap, bw, bh, c.color);
+        ref_bitmap(fb_ref, c.x + ox, c.y + oy, bitmap, bw, bh, 1, &expect, c.color);
+        epaper_draw_bitmap_scaled(&epaper, c.x, c.y + 30, bitmap, bw, bh, scale, c.color ^ 0xFF);
+        ref_bitmap(fb_ref, c.x + ox, c.y + oy + 30, bitmap, bw, bh, scale, &expect, c.color ^ 0xFF);
+        bad_bitmap += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+
+        if (negative) {
+            continue;
+        }
+
+        // 其他圖形：面板座標 (沒有 viewport) 繪製後只保留裁切矩形內的像素
+        for (size_t k = 0; k < CASE_COUNT; k++) {
+            memcpy(fb_draw, fb_orig, EPAPER_BUFFER_SIZE);
+            cases[k].draw(&epaper, 0, 0, &c);
+
+            memcpy(fb_screen, fb_orig, EPAPER_BUFFER_SIZE);
+            cases[k].draw(&screen, ox, oy, &c);
+            ref_masked(&expect);
+            bad_case[k] += memcmp(fb_draw, fb_ref, EPAPER_BUFFER_SIZE) != 0;
+        }
+    }
+    epaper_reset_viewport(&epaper);
+
+    failures += report("clip rectangle", bad_clip, iterations);
+    failures += report("bitmap / scaled bitmap", bad_bitmap, iterations);
+    for (size_t k = 0; k < CASE_COUNT; k++) {
+        failures += report(cases[k].name, bad_case[k], iterations / 2);
+    }
+    failures += report("stack depth / draw stream", check_stack(), 1);
+
+    printf("viewport: %d failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,595 @@
+/*
+ * 繪圖指令串流實作
+ *
+ * 版本: v1.5
+ * 日期: 2025-11-19
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "draw_commands.h"
+#include "text_layout.h"
+
+static const char *TAG = "DrawCmd";
+
+// 各指令固定部分的長度 (不含 opcode 本身)
+#define RECT_ARGS_SIZE          9   // x, y, w, h, color
+#define LINE_ARGS_SIZE          9   // x0, y0, x1, y1, color
+#define BLIT_ARGS_SIZE          6   // asset_id, x, y, color
+#define BLIT_SCALED_ARGS_SIZE   7   // asset_id, x, y, scale, color
+#define TEXT_ARGS_SIZE          7   // x, y, font_id, color, len
+#define ASSET_ARGS_SIZE         5   // asset_id, w, h
+#define CLEAR_ARGS_SIZE         1   // color
+#define CIRCLE_ARGS_SIZE        8   // cx, cy, r, flags, color
+#define ROUND_RECT_ARGS_SIZE    12  // x, y, w, h, r, flags, color
+#define ARC_ARGS_SIZE           11  // cx, cy, r, start, end, color
+#define POLYGON_ARGS_SIZE       3   // flags, color, count
+#define POLYGON_POINT_SIZE      4   // x, y
+#define VIEWPORT_ARGS_SIZE      8   // x, y, w, h
+#define MOVE_ARGS_SIZE          13  // x, y, w, h, dx, dy, fill
+#define TEXT_BOX_ARGS_SIZE      12  // x, y, w, h, font_id, flags, color, len
+
+// Asset 儲存
+typedef struct {
+    uint8_t *bitmap;
+    uint16_t w;
+    uint16_t h;
+} draw_asset_t;
+
+static draw_asset_t assets[DRAW_MAX_ASSETS];
+
+// TEXT_BOX 排版結果 (字串最多 255 bytes，字形數不會超過 255；
+// 串流只在持有排程器鎖時執行，可以共用靜態緩衝)
+static text_glyph_t box_glyphs[255];
+static text_layout_t box_layout;
+
+// 驗證階段預先配置的 asset 空間 (每個 asset_id 取這段串流中最大的定義)，
+// 確保繪製階段不會因記憶體不足而中途失敗
+static uint8_t *staged[DRAW_MAX_ASSETS];
+static uint32_t staged_size[DRAW_MAX_ASSETS];
+
+// ============================================
+// 輔助函數
+// ============================================
+
+static inline uint16_t read_u16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t asset_bitmap_size(uint16_t w, uint16_t h)
+{
+    return (uint32_t)((w + 7) / 8) * h;
+}
+
+static uint32_t assets_total_size(void)
+{
+    uint32_t total = 0;
+    for (int i = 0; i < DRAW_MAX_ASSETS; i++) {
+        if (assets[i].bitmap != NULL) {
+            total += asset_bitmap_size(assets[i].w, assets[i].h);
+        }
+    }
+    return total;
+}
+
+/**
+ * 將矩形加入受影響範圍
+ * 座標相對於目前的 viewport，換算成面板座標並裁切到目前的裁切矩形
+ */
+static void bounds_add(draw_bounds_t *b, const epaper_t *epaper, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    epaper_rect_t r;
+    if (!epaper_clip_rect(epaper, x, y, w, h, &r)) {
+        return;
+    }
+
+    if (!b->valid) {
+        b->x0 = r.x0;
+        b->y0 = r.y0;
+        b->x1 = r.x1;
+        b->y1 = r.y1;
+        b->valid = true;
+        return;
+    }
+
+    if (r.x0 < b->x0) b->x0 = r.x0;
+    if (r.y0 < b->y0) b->y0 = r.y0;
+    if (r.x1 > b->x1) b->x1 = r.x1;
+    if (r.y1 > b->y1) b->y1 = r.y1;
+}
+
+/**
+ * 將多邊形頂點的外接矩形加入受影響範圍
+ */
+static void bounds_add_points(draw_bounds_t *b, const epaper_t *epaper,
+                              const epaper_point_t *points, uint16_t count)
+{
+    int32_t x0 = INT32_MAX, y0 = INT32_MAX, x1 = INT32_MIN, y1 = INT32_MIN;
+    for (uint16_t i = 0; i < count; i++) {
+        if (points[i].x < x0) x0 = points[i].x;
+        if (points[i].y < y0) y0 = points[i].y;
+        if (points[i].x > x1) x1 = points[i].x;
+        if (points[i].y > y1) y1 = points[i].y;
+    }
+    bounds_add(b, epaper, x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+}
+
+/**
+ * 將圓心 (cx, cy)、半徑 r 的外接方形加入受影響範圍
+ */
+static void bounds_add_circle(draw_bounds_t *b, const epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r)
+{
+    bounds_add(b, epaper, (int32_t)cx - r, (int32_t)cy - r, 2 * (int32_t)r + 1, 2 * (int32_t)r + 1);
+}
+
+/**
+ * 釋放尚未使用的預先配置空間
+ */
+static void staged_release(void)
+{
+    for (int i = 0; i < DRAW_MAX_ASSETS; i++) {
+        free(staged[i]);
+        staged[i] = NULL;
+        staged_size[i] = 0;
+    }
+}
+
+/**
+ * 依驗證階段記錄的大小預先配置 asset 空間
+ */
+static esp_err_t staged_reserve(void)
+{
+    for (int i = 0; i < DRAW_MAX_ASSETS; i++) {
+        if (staged_size[i] == 0) {
+            continue;
+        }
+        staged[i] = (uint8_t *)malloc(staged_size[i]);
+        if (staged[i] == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate asset %d (%lu bytes)", i, staged_size[i]);
+            staged_release();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * 定義 (或取代) asset
+ *
+ * 使用預先配置的空間；同一段串流重複定義同一個 asset 時沿用第一次換上的空間
+ * (容量為這段串流中該 asset 的最大定義)，因此不會失敗。
+ */
+static void define_asset(uint8_t id, uint16_t w, uint16_t h, const uint8_t *bitmap)
+{
+    uint32_t size = asset_bitmap_size(w, h);
+    if (staged[id] != NULL) {
+        free(assets[id].bitmap);
+        assets[id].bitmap = staged[id];
+        staged[id] = NULL;
+    }
+    memcpy(assets[id].bitmap, bitmap, size);
+    assets[id].w = w;
+    assets[id].h = h;
+
+    ESP_LOGI(TAG, "Asset %d defined: %dx%d (%lu bytes)", id, w, h, size);
+}
+
+// ============================================
+// 指令解析
+// ============================================
+
+/**
+ * 走訪整段指令串流
+ *
+ * dry_run = true 時只驗證格式並模擬 asset 空間，不修改任何狀態，
+ * 並記錄每個 asset 需要預先配置的大小 (staged_size)。
+ */
+static esp_err_t run_ops(epaper_t *epaper, const uint8_t *ops, uint32_t len,
+                         draw_bounds_t *bounds, bool dry_run)
+{
+    // 模擬 asset 狀態，讓驗證階段就能發現 BLIT 未定義 asset 或超出空間
+    uint32_t sim_size[DRAW_MAX_ASSETS];
+    uint32_t sim_total = 0;
+    for (int i = 0; i < DRAW_MAX_ASSETS; i++) {
+        sim_size[i] = assets[i].bitmap ? asset_bitmap_size(assets[i].w, assets[i].h) : 0;
+        sim_total += sim_size[i];
+    }
+
+    // 模擬 viewport 堆疊深度：只能 pop 這段串流自己 push 的層
+    uint8_t base_depth = epaper->view_depth;
+    uint8_t sim_depth = base_depth;
+
+    uint32_t pos = 0;
+    while (pos < len) {
+        uint8_t op = ops[pos++];
+        const uint8_t *args = ops + pos;
+        uint32_t remain = len - pos;
+
+        switch (op) {
+            case DRAW_OP_FILL_RECT:
+            case DRAW_OP_DRAW_RECT: {
+                if (remain < RECT_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x = read_u16(args);
+                uint16_t y = read_u16(args + 2);
+                uint16_t w = read_u16(args + 4);
+                uint16_t h = read_u16(args + 6);
+                uint8_t color = args[8];
+                if (!dry_run) {
+                    if (op == DRAW_OP_FILL_RECT) {
+                        epaper_fill_rect(epaper, x, y, w, h, color);
+                    } else {
+                        epaper_draw_rect(epaper, x, y, w, h, color);
+                    }
+                    bounds_add(bounds, epaper, x, y, w, h);
+                }
+                pos += RECT_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_LINE: {
+                if (remain < LINE_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x0 = read_u16(args);
+                uint16_t y0 = read_u16(args + 2);
+                uint16_t x1 = read_u16(args + 4);
+                uint16_t y1 = read_u16(args + 6);
+                uint8_t color = args[8];
+                if (!dry_run) {
+                    epaper_draw_line(epaper, x0, y0, x1, y1, color);
+                    uint16_t lx = x0 < x1 ? x0 : x1;
+                    uint16_t ly = y0 < y1 ? y0 : y1;
+                    int32_t lw = (x0 < x1 ? (int32_t)x1 - x0 : (int32_t)x0 - x1) + 1;
+                    int32_t lh = (y0 < y1 ? (int32_t)y1 - y0 : (int32_t)y0 - y1) + 1;
+                    bounds_add(bounds, epaper, lx, ly, lw, lh);
+                }
+                pos += LINE_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_CIRCLE: {
+                if (remain < CIRCLE_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t cx = read_u16(args);
+                uint16_t cy = read_u16(args + 2);
+                uint16_t r = read_u16(args + 4);
+                uint8_t flags = args[6];
+                uint8_t color = args[7];
+                if (!dry_run) {
+                    if (flags & DRAW_FLAG_FILL) {
+                        epaper_fill_circle(epaper, cx, cy, r, color);
+                    } else {
+                        epaper_draw_circle(epaper, cx, cy, r, color);
+                    }
+                    bounds_add_circle(bounds, epaper, cx, cy, r);
+                }
+                pos += CIRCLE_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_ROUND_RECT: {
+                if (remain < ROUND_RECT_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x = read_u16(args);
+                uint16_t y = read_u16(args + 2);
+                uint16_t w = read_u16(args + 4);
+                uint16_t h = read_u16(args + 6);
+                uint16_t r = read_u16(args + 8);
+                uint8_t flags = args[10];
+                uint8_t color = args[11];
+                if (!dry_run) {
+                    if (flags & DRAW_FLAG_FILL) {
+                        epaper_fill_round_rect(epaper, x, y, w, h, r, color);
+                    } else {
+                        epaper_draw_round_rect(epaper, x, y, w, h, r, color);
+                    }
+                    bounds_add(bounds, epaper, x, y, w, h);
+                }
+                pos += ROUND_RECT_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_ARC: {
+                if (remain < ARC_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t cx = read_u16(args);
+                uint16_t cy = read_u16(args + 2);
+                uint16_t r = read_u16(args + 4);
+                uint16_t start = read_u16(args + 6);
+                uint16_t end = read_u16(args + 8);
+                uint8_t color = args[10];
+                if (start > 360 || end > 360) {
+                    ESP_LOGE(TAG, "ARC: invalid angle %d..%d", start, end);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (!dry_run) {
+                    epaper_draw_arc(epaper, cx, cy, r, (int16_t)start, (int16_t)end, color);
+                    bounds_add_circle(bounds, epaper, cx, cy, r);
+                }
+                pos += ARC_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_POLYGON: {
+                if (remain < POLYGON_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint8_t flags = args[0];
+                uint8_t color = args[1];
+                uint8_t count = args[2];
+                uint32_t size = POLYGON_ARGS_SIZE + (uint32_t)count * POLYGON_POINT_SIZE;
+                if (remain < size) return ESP_ERR_INVALID_SIZE;
+                uint8_t min_count = (flags & DRAW_FLAG_FILL) ? 3 : 1;
+                if (count < min_count || count > EPAPER_POLY_MAX_POINTS) {
+                    ESP_LOGE(TAG, "POLYGON: invalid vertex count %d", count);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (!dry_run) {
+                    epaper_point_t points[EPAPER_POLY_MAX_POINTS];
+                    for (uint8_t i = 0; i < count; i++) {
+                        const uint8_t *p = args + POLYGON_ARGS_SIZE + i * POLYGON_POINT_SIZE;
+                        points[i].x = (int16_t)read_u16(p);
+                        points[i].y = (int16_t)read_u16(p + 2);
+                    }
+                    if (flags & DRAW_FLAG_FILL) {
+                        epaper_fill_rule_t rule = (flags & DRAW_FLAG_NONZERO) ?
+                                                  EPAPER_FILL_NONZERO : EPAPER_FILL_EVEN_ODD;
+                        epaper_fill_polygon(epaper, points, count, rule, color);
+                    } else {
+                        epaper_draw_polygon(epaper, points, count, !(flags & DRAW_FLAG_OPEN), color);
+                    }
+                    bounds_add_points(bounds, epaper, points, count);
+                }
+                pos += size;
+                break;
+            }
+
+            case DRAW_OP_BLIT: {
+                if (remain < BLIT_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint8_t id = args[0];
+                uint16_t x = read_u16(args + 1);
+                uint16_t y = read_u16(args + 3);
+                uint8_t color = args[5];
+                if (id >= DRAW_MAX_ASSETS || sim_size[id] == 0) {
+                    ESP_LOGE(TAG, "BLIT: asset %d not defined", id);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (!dry_run) {
+                    draw_asset_t *a = &assets[id];
+                    epaper_draw_bitmap(epaper, x, y, a->bitmap, a->w, a->h, color);
+                    bounds_add(bounds, epaper, x, y, a->w, a->h);
+                }
+                pos += BLIT_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_BLIT_SCALED: {
+                if (remain < BLIT_SCALED_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint8_t id = args[0];
+                uint16_t x = read_u16(args + 1);
+                uint16_t y = read_u16(args + 3);
+                uint8_t scale = args[5];
+                uint8_t color = args[6];
+                if (id >= DRAW_MAX_ASSETS || sim_size[id] == 0) {
+                    ESP_LOGE(TAG, "BLIT_SCALED: asset %d not defined", id);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (scale == 0 || scale > DRAW_MAX_SCALE) {
+                    ESP_LOGE(TAG, "BLIT_SCALED: invalid scale %d", scale);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (!dry_run) {
+                    draw_asset_t *a = &assets[id];
+                    epaper_draw_bitmap_scaled(epaper, x, y, a->bitmap, a->w, a->h, scale, color);
+                    bounds_add(bounds, epaper, x, y, a->w * scale, a->h * scale);
+                }
+                pos += BLIT_SCALED_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_TEXT: {
+                if (remain < TEXT_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x = read_u16(args);
+                uint16_t y = read_u16(args + 2);
+                uint8_t font_id = args[4];
+                uint8_t color = args[5];
+                uint8_t text_len = args[6];
+                if (remain < TEXT_ARGS_SIZE + (uint32_t)text_len) return ESP_ERR_INVALID_SIZE;
+                if (font_id == 1 || font_id > DRAW_MAX_SCALE) {
+                    ESP_LOGE(TAG, "TEXT: unsupported font id %d", font_id);
+                    return ESP_ERR_NOT_SUPPORTED;
+                }
+                if (!dry_run) {
+                    // 串流中的字串沒有結尾 '\0'，先複製出來
+                    char text[256];
+                    memcpy(text, args + TEXT_ARGS_SIZE, text_len);
+                    text[text_len] = '\0';
+                    uint8_t scale = (font_id == DRAW_FONT_DEFAULT) ? 1 : font_id;
+                    epaper_draw_string_scaled(epaper, x, y, text, scale, color);
+                    bounds_add(bounds, epaper, x, y, (uint32_t)epaper_measure_string(text) * scale, 16 * scale);
+                }
+                pos += TEXT_ARGS_SIZE + text_len;
+                break;
+            }
+
+            case DRAW_OP_TEXT_BOX: {
+                if (remain < TEXT_BOX_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x = read_u16(args);
+                uint16_t y = read_u16(args + 2);
+                uint16_t w = read_u16(args + 4);
+                uint16_t h = read_u16(args + 6);
+                uint8_t font_id = args[8];
+                uint8_t flags = args[9];
+                uint8_t color = args[10];
+                uint8_t text_len = args[11];
+                if (remain < TEXT_BOX_ARGS_SIZE + (uint32_t)text_len) return ESP_ERR_INVALID_SIZE;
+                if (font_id == 1 || font_id > DRAW_MAX_SCALE) {
+                    ESP_LOGE(TAG, "TEXT_BOX: unsupported font id %d", font_id);
+                    return ESP_ERR_NOT_SUPPORTED;
+                }
+                if ((flags & DRAW_TEXT_ALIGN_MASK) > TEXT_ALIGN_RIGHT) {
+                    ESP_LOGE(TAG, "TEXT_BOX: invalid align %d", flags & DRAW_TEXT_ALIGN_MASK);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (!dry_run) {
+                    char text[256];
+                    memcpy(text, args + TEXT_BOX_ARGS_SIZE, text_len);
+                    text[text_len] = '\0';
+                    text_style_t style = TEXT_STYLE_DEFAULT();
+                    style.scale = (font_id == DRAW_FONT_DEFAULT) ? 1 : font_id;
+                    style.proportional = (flags & DRAW_TEXT_PROPORTIONAL) != 0;
+                    text_layout(text, &style, w, h, (text_align_t)(flags & DRAW_TEXT_ALIGN_MASK),
+                                box_glyphs, sizeof(box_glyphs) / sizeof(box_glyphs[0]), &box_layout);
+                    text_render(epaper, x, y, &box_layout, color);
+                    if (box_layout.count > 0) {
+                        bounds_add(bounds, epaper, x, y, w, box_layout.height);
+                    }
+                }
+                pos += TEXT_BOX_ARGS_SIZE + text_len;
+                break;
+            }
+
+            case DRAW_OP_DEFINE_ASSET: {
+                if (remain < ASSET_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint8_t id = args[0];
+                uint16_t w = read_u16(args + 1);
+                uint16_t h = read_u16(args + 3);
+                uint32_t size = asset_bitmap_size(w, h);
+                if (remain < ASSET_ARGS_SIZE + size) return ESP_ERR_INVALID_SIZE;
+                if (id >= DRAW_MAX_ASSETS || size == 0) {
+                    ESP_LOGE(TAG, "DEFINE_ASSET: invalid asset %d (%dx%d)", id, w, h);
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (sim_total - sim_size[id] + size > DRAW_ASSET_BUDGET) {
+                    ESP_LOGE(TAG, "DEFINE_ASSET: budget exceeded (%lu + %lu > %d)",
+                             sim_total - sim_size[id], size, DRAW_ASSET_BUDGET);
+                    return ESP_ERR_NO_MEM;
+                }
+                sim_total = sim_total - sim_size[id] + size;
+                sim_size[id] = size;
+                if (dry_run) {
+                    if (size > staged_size[id]) staged_size[id] = size;
+                } else {
+                    define_asset(id, w, h, args + ASSET_ARGS_SIZE);
+                }
+                pos += ASSET_ARGS_SIZE + size;
+                break;
+            }
+
+            case DRAW_OP_CLEAR: {
+                if (remain < CLEAR_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                if (!dry_run) {
+                    if (epaper->view_depth > 0) {
+                        // VIEWPORT 內只清除 viewport 的範圍
+                        const epaper_rect_t *clip = &epaper->view.clip;
+                        epaper_fill_clip(epaper, args[0]);
+                        bounds_add(bounds, epaper, clip->x0 - epaper->view.ox, clip->y0 - epaper->view.oy,
+                                   clip->x1 - clip->x0 + 1, clip->y1 - clip->y0 + 1);
+                    } else {
+                        epaper_clear_screen(epaper, args[0]);
+                        bounds_add(bounds, epaper, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+                    }
+                }
+                pos += CLEAR_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_MOVE: {
+                if (remain < MOVE_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                uint16_t x = read_u16(args);
+                uint16_t y = read_u16(args + 2);
+                uint16_t w = read_u16(args + 4);
+                uint16_t h = read_u16(args + 6);
+                int16_t dx = (int16_t)read_u16(args + 8);
+                int16_t dy = (int16_t)read_u16(args + 10);
+                uint8_t fill = args[12];
+                if (!dry_run) {
+                    epaper_move_region(epaper, x, y, w, h, dx, dy, fill);
+                    bounds_add(bounds, epaper, x, y, w, h);
+                    bounds_add(bounds, epaper, (int32_t)x + dx, (int32_t)y + dy, w, h);
+                }
+                pos += MOVE_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_VIEWPORT: {
+                if (remain < VIEWPORT_ARGS_SIZE) return ESP_ERR_INVALID_SIZE;
+                int16_t x = (int16_t)read_u16(args);
+                int16_t y = (int16_t)read_u16(args + 2);
+                uint16_t w = read_u16(args + 4);
+                uint16_t h = read_u16(args + 6);
+                if (sim_depth >= EPAPER_VIEW_DEPTH) {
+                    ESP_LOGE(TAG, "VIEWPORT: nested too deep");
+                    return ESP_ERR_INVALID_ARG;
+                }
+                sim_depth++;
+                if (!dry_run) {
+                    epaper_push_viewport(epaper, x, y, w, h);
+                }
+                pos += VIEWPORT_ARGS_SIZE;
+                break;
+            }
+
+            case DRAW_OP_VIEWPORT_POP: {
+                if (sim_depth <= base_depth) {
+                    ESP_LOGE(TAG, "VIEWPORT_POP without VIEWPORT");
+                    return ESP_ERR_INVALID_ARG;
+                }
+                sim_depth--;
+                if (!dry_run) {
+                    epaper_pop_viewport(epaper);
+                }
+                break;
+            }
+
+            default:
+                ESP_LOGE(TAG, "Unknown draw op 0x%02X at offset %lu", op, pos - 1);
+                return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    return ESP_OK;
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+esp_err_t draw_commands_execute(epaper_t *epaper, const uint8_t *ops, uint32_t len, draw_bounds_t *bounds)
+{
+    if (epaper == NULL || bounds == NULL || (ops == NULL && len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(bounds, 0, sizeof(*bounds));
+
+    // 第一階段：驗證並預先配置 asset 空間 (不修改 framebuffer)
+    esp_err_t ret = run_ops(epaper, ops, len, bounds, true);
+    if (ret == ESP_OK) {
+        ret = staged_reserve();
+    } else {
+        staged_release();
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Draw stream rejected: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 第二階段：實際繪製
+    uint8_t depth = epaper->view_depth;
+    ret = run_ops(epaper, ops, len, bounds, false);
+
+    // 串流結束時關閉未 pop 的 VIEWPORT
+    while (epaper->view_depth > depth) {
+        epaper_pop_viewport(epaper);
+    }
+    staged_release();
+
+    ESP_LOGI(TAG, "Draw stream executed: %lu bytes, assets=%lu bytes", len, assets_total_size());
+    return ret;
+}
+
+void draw_commands_clear_assets(void)
+{
+    for (int i = 0; i < DRAW_MAX_ASSETS; i++) {
+        free(assets[i].bitmap);
+        assets[i].bitmap = NULL;
+        assets[i].w = 0;
+        assets[i].h = 0;
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * 繪圖指令串流 (Draw Command Stream)
+ *
+ * 伺服器不再傳送整張 48KB 點陣圖，而是傳送精簡的二進位繪圖指令，
+ * 由裝置端使用 epaper_driver 的繪圖函數直接畫到 framebuffer，
+ * 並回報受影響的區域，只對該區域做部分更新。
+ *
+ * 指令格式 (所有多位元組欄位皆為小端序 Little-Endian)：
+ *
+ *   0x01 FILL_RECT     x:u16 y:u16 w:u16 h:u16 color:u8
+ *   0x02 DRAW_RECT     x:u16 y:u16 w:u16 h:u16 color:u8
+ *   0x03 LINE          x0:u16 y0:u16 x1:u16 y1:u16 color:u8
+ *   0x04 BLIT          asset_id:u8 x:u16 y:u16 color:u8
+ *   0x05 TEXT          x:u16 y:u16 font_id:u8 color:u8 len:u8 utf8[len]
+ *   0x06 DEFINE_ASSET  asset_id:u8 w:u16 h:u16 bitmap[((w+7)/8)*h]
+ *   0x07 CLEAR         color:u8
+ *   0x08 BLIT_SCALED   asset_id:u8 x:u16 y:u16 scale:u8 color:u8
+ *   0x09 CIRCLE        cx:u16 cy:u16 r:u16 flags:u8 color:u8
+ *   0x0A ROUND_RECT    x:u16 y:u16 w:u16 h:u16 r:u16 flags:u8 color:u8
+ *   0x0B ARC           cx:u16 cy:u16 r:u16 start:u16 end:u16 color:u8
+ *   0x0C POLYGON       flags:u8 color:u8 count:u8 (x:i16 y:i16)[count]
+ *   0x0D VIEWPORT      x:i16 y:i16 w:u16 h:u16
+ *   0x0E VIEWPORT_POP
+ *   0x0F MOVE          x:u16 y:u16 w:u16 h:u16 dx:i16 dy:i16 fill:u8
+ *   0x10 TEXT_BOX      x:u16 y:u16 w:u16 h:u16 font_id:u8 flags:u8 color:u8 len:u8 utf8[len]
+ *
+ * color: 0x00 = 黑色, 0xFF = 白色 (與 COLOR_BLACK / COLOR_WHITE 相同)
+ * font_id: 0 = 內建 8x16 ASCII / 16x16 中文；2~8 = 內建字型放大 font_id 倍 (大字體時鐘、標題)
+ * scale: 1~8，每個像素放大成 scale x scale
+ * flags: bit0 = 填滿 (DRAW_FLAG_FILL)，否則只畫外框
+ *        POLYGON 另有 bit1 = 非零環繞規則 (DRAW_FLAG_NONZERO，預設奇偶規則)、
+ *        bit2 = 不封閉的折線 (DRAW_FLAG_OPEN，只用於外框，例如折線圖)
+ * VIEWPORT: 之後的指令座標相對於 (x, y)，並裁切到 w x h (可巢狀，最多 EPAPER_VIEW_DEPTH 層)，
+ *           受影響範圍也只包含 viewport 內實際繪製的部分；VIEWPORT_POP 回到上一層，
+ *           串流結束時未 pop 的 viewport 自動關閉。CLEAR 在 viewport 內只清除 viewport
+ * MOVE: 將區域內容平移 (dx, dy)，移開後露出的部分填入 fill；目的區域裁切到目前的 viewport，
+ *       在 VIEWPORT 內移動即為捲動 (日誌、跑馬燈只需新增一行文字，不必重畫整個區域)
+ * TEXT_BOX: 在 w x h 的方框內自動換行排版 (英文以單字換行，中文逐字並遵守禁則)，放不下的行截斷；
+ *           flags bit0-1 = 對齊 (0 靠左、1 置中、2 靠右)，bit2 = ASCII 使用比例寬度 (DRAW_TEXT_PROPORTIONAL)
+ * POLYGON 頂點為有號座標，可以超出螢幕；填滿需要 3 個以上頂點，最多 EPAPER_POLY_MAX_POINTS 個
+ * start / end: 角度 0~360，0 度在右方，順時針畫
+ *
+ * 版本: v1.5
+ * 日期: 2025-11-19
+ */
+
+#ifndef DRAW_COMMANDS_H
+#define DRAW_COMMANDS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "epaper_driver.h"
+
+// 指令代碼
+#define DRAW_OP_FILL_RECT       0x01
+#define DRAW_OP_DRAW_RECT       0x02
+#define DRAW_OP_LINE            0x03
+#define DRAW_OP_BLIT            0x04
+#define DRAW_OP_TEXT            0x05
+#define DRAW_OP_DEFINE_ASSET    0x06
+#define DRAW_OP_CLEAR           0x07
+#define DRAW_OP_BLIT_SCALED     0x08
+#define DRAW_OP_CIRCLE          0x09
+#define DRAW_OP_ROUND_RECT      0x0A
+#define DRAW_OP_ARC             0x0B
+#define DRAW_OP_POLYGON         0x0C
+#define DRAW_OP_VIEWPORT        0x0D
+#define DRAW_OP_VIEWPORT_POP    0x0E
+#define DRAW_OP_MOVE            0x0F
+#define DRAW_OP_TEXT_BOX        0x10
+
+// 圖形旗標
+#define DRAW_FLAG_FILL          0x01
+#define DRAW_FLAG_NONZERO       0x02
+#define DRAW_FLAG_OPEN          0x04
+
+// TEXT_BOX 旗標
+#define DRAW_TEXT_ALIGN_MASK    0x03    // text_align_t
+#define DRAW_TEXT_PROPORTIONAL  0x04
+
+// 字型代碼 (內建 8x16 ASCII + 16x16 中文，2~8 為放大倍數)
+#define DRAW_FONT_DEFAULT       0x00
+#define DRAW_MAX_SCALE          8
+
+// 圖素資源 (asset) 限制
+#define DRAW_MAX_ASSETS         16
+#define DRAW_ASSET_BUDGET       (8 * 1024)  // 所有 asset 點陣圖合計上限
+
+// 受影響區域 (包含邊界: x0..x1, y0..y1)
+typedef struct {
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+    bool valid;
+} draw_bounds_t;
+
+/**
+ * 執行繪圖指令串流
+ *
+ * 會先完整驗證整段指令並預先配置 asset 空間，格式錯誤或記憶體不足時不修改 framebuffer。
+ *
+ * @param epaper  E-Paper 驅動
+ * @param ops     指令串流
+ * @param len     指令串流長度
+ * @param bounds  輸出：所有指令影響的範圍 (已裁切至螢幕)
+ * @return ESP_OK 成功；ESP_ERR_INVALID_SIZE 指令被截斷；
+ *         ESP_ERR_INVALID_ARG 未知指令或 asset；ESP_ERR_NOT_SUPPORTED 不支援的字型；
+ *         ESP_ERR_NO_MEM asset 空間不足
+ */
+esp_err_t draw_commands_execute(epaper_t *epaper, const uint8_t *ops, uint32_t len, draw_bounds_t *bounds);
+
+/**
+ * 釋放所有已定義的 asset
+ */
+void draw_commands_clear_assets(void);
+
+#endif // DRAW_COMMANDS_H
@@ -7,14 +7,45 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "esp_system.h"
 #include "epaper_driver.h"
 #include "font.h"
+#include "utf8.h"
+#include "font_store.h"
+#include "glyph_cache.h"
+#include "text_cache.h"
 
 static const char *TAG = "EPaper";
 
+// 進入深度睡眠時保存在 RTC 記憶體的驅動狀態
+#define EPAPER_RTC_MAGIC    0x45504431u  // "EPD1"
+
+typedef struct {
+    uint32_t magic;                 // 只有 epaper_sleep() 寫入時有效
+    uint32_t frame_hash;            // 面板上顯示的畫面雜湊
+    bool prev_ram_valid;
+    uint8_t full_profile;
+    uint8_t partial_profile;
+} epaper_rtc_state_t;
+
+static RTC_DATA_ATTR epaper_rtc_state_t rtc_state;
+
+// 面板設定指令序列：{ cmd, 資料長度, 資料... } (參考 GxEPD2_426_GDEQ0426T82)
+static const uint8_t init_config_seq[] = {
+    0x18, 1, 0x80,                                  // Temperature sensor: internal
+    0x0C, 5, 0xAE, 0xC7, 0xC3, 0xC0, 0x80,          // Booster soft start
+    0x01, 3, (EPAPER_HEIGHT - 1) % 256,             // Driver output control (gates)
+             (EPAPER_HEIGHT - 1) / 256, 0x02,       //   SM (interlaced)
+    0x3C, 1, 0x01,                                  // Border waveform
+    0x11, 1, 0x01,                                  // Data entry: X increment, Y decrement
+};
+
 // ============================================
 // GPIO 控制函數
 // ============================================
@@ -56,9 +87,12 @@ void epaper_reset(void)
 
 /**
  * 等待 BUSY 信號變為低電平 (空閒)
+ * 
+ * @return 實際等待時間 (微秒)
  */
-void epaper_wait_busy(void)
+uint32_t epaper_wait_busy(void)
 {
+    int64_t start_us = esp_timer_get_time();
     ESP_LOGI(TAG, "Waiting for display ready...");
     uint32_t timeout = 0;
     const uint32_t max_timeout = 300;  // 3 秒超時 (適合部分更新)
@@ -75,6 +109,64 @@ void epaper_wait_busy(void)
     if (timeout < max_timeout) {
         ESP_LOGI(TAG, "Display ready (waited %d ms)", timeout * 10);
     }
+    
+    return (uint32_t)(esp_timer_get_time() - start_us);
+}
+
+// ============================================
+// 統計函數
+// ============================================
+
+/**
+ * 清除計時統計
+ */
+void epaper_stats_reset(epaper_t *epaper)
+{
+    int8_t panel_temperature = epaper->stats.panel_temperature;
+    uint8_t fast_temperature = epaper->stats.fast_temperature;
+    
+    memset(&epaper->stats, 0, sizeof(epaper->stats));
+    
+    // 溫度是面板狀態而非單次更新的計時，保留最後一次讀值
+    epaper->stats.panel_temperature = panel_temperature;
+    epaper->stats.fast_temperature = fast_temperature;
+}
+
+/**
+ * 記錄一次刷新 (busy_start_us 為 Master Activation 送出的時間)
+ */
+static void epaper_record_refresh(epaper_t *epaper, epaper_refresh_mode_t mode,
+                                  epaper_lut_profile_t profile, int64_t busy_start_us)
+{
+    uint32_t busy_us = (uint32_t)(esp_timer_get_time() - busy_start_us);
+    
+    epaper->stats.busy_us += busy_us;
+    epaper->stats.refresh_count++;
+    epaper->stats.last_refresh = mode;
+    epaper->stats.last_profile = profile;
+    
+    epaper_lut_stats_t *ps = &epaper->profile_stats[profile];
+    ps->count++;
+    ps->last_us = busy_us;
+    ps->total_us += busy_us;
+    ESP_LOGI(TAG, "Refresh [%s]: %lu ms (avg %lu ms over %lu)",
+             epaper_lut_get(profile)->name, busy_us / 1000,
+             ps->total_us / ps->count / 1000, ps->count);
+}
+
+/**
+ * 執行 SPI 傳輸並累計時間與位元組數
+ */
+static esp_err_t epaper_spi_transmit(epaper_t *epaper, spi_transaction_t *t)
+{
+    int64_t start_us = esp_timer_get_time();
+    if (epaper->wake_to_spi_us == 0) {
+        epaper->wake_to_spi_us = (uint32_t)start_us;  // esp_timer 從開機開始計時
+    }
+    esp_err_t ret = spi_device_transmit(epaper->spi, t);
+    epaper->stats.spi_us += (uint32_t)(esp_timer_get_time() - start_us);
+    epaper->stats.spi_bytes += t->length / 8;
+    return ret;
 }
 
 // ============================================
@@ -94,7 +186,7 @@ void epaper_send_command(epaper_t *epaper, uint8_t cmd)
         .rx_buffer = NULL
     };
     
-    esp_err_t ret = spi_device_transmit(epaper->spi, &t);
+    esp_err_t ret = epaper_spi_transmit(epaper, &t);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "SPI command send failed: %s", esp_err_to_name(ret));
     }
@@ -113,7 +205,7 @@ void epaper_send_data(epaper_t *epaper, uint8_t data)
         .rx_buffer = NULL
     };
     
-    esp_err_t ret = spi_device_transmit(epaper->spi, &t);
+    esp_err_t ret = epaper_spi_transmit(epaper, &t);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "SPI data send failed: %s", esp_err_to_name(ret));
     }
@@ -141,7 +233,7 @@ void epaper_send_data_bulk(epaper_t *epaper, const uint8_t *data, size_t len)
             .rx_buffer = NULL
         };
         
-        esp_err_t ret = spi_device_transmit(epaper->spi, &t);
+        esp_err_t ret = epaper_spi_transmit(epaper, &t);
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "SPI bulk data send failed at offset %d: %s", offset, esp_err_to_name(ret));
             return;
@@ -151,12 +243,126 @@ void epaper_send_data_bulk(epaper_t *epaper, const uint8_t *data, size_t len)
     }
 }
 
+/**
+ * 發送指令序列 { cmd, 資料長度, 資料... }
+ * 每個指令的資料以單次 SPI 傳輸送出
+ */
+static void epaper_send_sequence(epaper_t *epaper, const uint8_t *seq, size_t len)
+{
+    size_t pos = 0;
+    while (pos + 2 <= len) {
+        uint8_t cmd = seq[pos];
+        uint8_t data_len = seq[pos + 1];
+        uint8_t data[8];
+        
+        memcpy(data, &seq[pos + 2], data_len);  // 複製到 RAM，避免 DMA 讀取 flash
+        epaper_send_command(epaper, cmd);
+        epaper_send_data_bulk(epaper, data, data_len);
+        pos += 2 + data_len;
+    }
+}
+
+/**
+ * 讀取資料 (3-wire，經由 MOSI 腳位)
+ */
+esp_err_t epaper_read_data(epaper_t *epaper, uint8_t *data, size_t len)
+{
+    if (len == 0) return ESP_OK;
+    
+    gpio_set_level(PIN_DC, 1);  // Data mode
+    
+    spi_transaction_t t = {
+        .length = 0,
+        .rxlength = len * 8,
+        .tx_buffer = NULL,
+        .rx_buffer = data
+    };
+    
+    esp_err_t ret = epaper_spi_transmit(epaper, &t);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI read failed: %s", esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+// ============================================
+// 溫度感測函數
+// ============================================
+
+/**
+ * 讀取面板內建溫度感測器
+ * 
+ * @param temperature 輸出：溫度 (°C)
+ */
+esp_err_t epaper_read_temperature(epaper_t *epaper, int8_t *temperature)
+{
+    // 觸發溫度量測
+    epaper_send_command(epaper, 0x22);  // Display Update Sequence
+    epaper_send_data(epaper, EPAPER_SEQ_LOAD_TEMP);
+    epaper_send_command(epaper, 0x20);  // Master Activation
+    epaper_wait_busy();
+    epaper->lut_loaded = NULL;          // 量測流程會從 OTP 載入 LUT
+    
+    // 讀取溫度暫存器 (12-bit，2 的補數，1/16 °C)
+    uint8_t raw[2] = {0};
+    epaper_send_command(epaper, 0x1B);
+    esp_err_t ret = epaper_read_data(epaper, raw, sizeof(raw));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    int16_t value = (int16_t)((raw[0] << 8) | raw[1]) >> 4;
+    
+    // 讀回極值 (0x7FF / 0x800) 表示感測器沒有回應
+    if (value == 0x7FF || value == -0x800) {
+        ESP_LOGW(TAG, "Temperature sensor not responding (raw 0x%02X%02X)", raw[0], raw[1]);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    *temperature = (int8_t)(value / 16);
+    
+    ESP_LOGI(TAG, "Panel temperature: %d C (raw 0x%02X%02X)", *temperature, raw[0], raw[1]);
+    return ESP_OK;
+}
+
+/**
+ * 取得快速全刷使用的溫度值，溫度快取過期時重新量測
+ */
+static uint8_t epaper_fast_temperature(epaper_t *epaper)
+{
+    int64_t now_us = esp_timer_get_time();
+    
+    if (!epaper->temperature_valid ||
+        now_us - epaper->temperature_time_us >= (int64_t)EPAPER_TEMP_INTERVAL_MS * 1000) {
+        int8_t temperature;
+        if (epaper_read_temperature(epaper, &temperature) == ESP_OK) {
+            epaper->temperature = temperature;
+            epaper->temperature_valid = true;
+        } else {
+            ESP_LOGW(TAG, "Panel temperature unavailable, using default fast mode");
+        }
+        // 讀取失敗時也更新時間，避免每次刷新都重試
+        epaper->temperature_time_us = now_us;
+    }
+    
+    uint8_t fast = epaper->temperature_valid ?
+                   epaper_lut_fast_temperature(epaper->temperature) : EPAPER_FAST_TEMP_DEFAULT;
+    
+    epaper->stats.panel_temperature = epaper->temperature;
+    epaper->stats.fast_temperature = fast;
+    return fast;
+}
+
 // ============================================
 // 初始化和控制函數
 // ============================================
 
+static bool epaper_read_frame(epaper_t *epaper);
+
 /**
  * 初始化 E-Paper 顯示器
+ * 
+ * 由 epaper_sleep() 後的深度睡眠喚醒時走暖啟動流程：面板 RAM 仍保留上一張畫面，
+ * 只需硬體重置離開睡眠並重新設定面板暫存器，略過 SWRESET 與 RAM 視窗設定
  */
 esp_err_t epaper_init(epaper_t *epaper)
 {
@@ -164,15 +370,20 @@ esp_err_t epaper_init(epaper_t *epaper)
         return ESP_ERR_INVALID_ARG;
     }
     
-    ESP_LOGI(TAG, "Initializing GDEQ0426T82 E-Paper Display (800x480)");
+    int64_t init_start_us = esp_timer_get_time();
+    bool warm = (esp_reset_reason() == ESP_RST_DEEPSLEEP && rtc_state.magic == EPAPER_RTC_MAGIC);
+    rtc_state.magic = 0;  // 面板狀態只在下一次 epaper_sleep() 前有效
     
-    // 初始化 GPIO
+    ESP_LOGI(TAG, "Initializing GDEQ0426T82 E-Paper Display (800x480, %s start)", warm ? "warm" : "cold");
+    
+    // 初始化 GPIO (睡眠期間 RST 被保持在高電位)
+    gpio_hold_dis(PIN_RST);
     epaper_gpio_init();
     
     // 配置 SPI 匯流排
     spi_bus_config_t buscfg = {
         .mosi_io_num = PIN_MOSI,
-        .miso_io_num = PIN_MISO,
+        .miso_io_num = -1,      // 讀取經由 MOSI (3-wire)
         .sclk_io_num = PIN_SCLK,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
@@ -191,7 +402,7 @@ esp_err_t epaper_init(epaper_t *epaper)
         .mode = 0,
         .spics_io_num = PIN_CS,
         .queue_size = 7,
-        .flags = 0,
+        .flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_3WIRE,  // 讀取溫度需要雙向 SDA
         .pre_cb = NULL
     };
     
@@ -211,8 +422,52 @@ esp_err_t epaper_init(epaper_t *epaper)
         return ESP_ERR_NO_MEM;
     }
     
+    // 暖啟動也必須重新配置：48 KB 的 framebuffer 放不進 RTC 記憶體 (8 KB)，
+    // 深度睡眠後一般 RAM 內容不保留，畫面改由面板 RAM 讀回 (見下方)
     ESP_LOGI(TAG, "Framebuffer allocated: %d bytes", EPAPER_BUFFER_SIZE);
+    epaper_reset_viewport(epaper);
+    epaper->lut_loaded = NULL;
+    memset(epaper->profile_stats, 0, sizeof(epaper->profile_stats));
+    epaper->temperature = 0;
+    epaper->temperature_valid = false;
+    epaper->temperature_time_us = 0;
+    epaper->warm_start = warm;
+    epaper->framebuffer_synced = false;  // framebuffer 與面板上的畫面不同 (或未知)
+    
+    if (warm) {
+        // 面板仍顯示上一張畫面，0x24 / 0x26 也保留著
+        epaper->frame_hash = rtc_state.frame_hash;
+        epaper->prev_ram_valid = rtc_state.prev_ram_valid;
+        epaper->full_profile = (epaper_lut_profile_t)rtc_state.full_profile;
+        epaper->partial_profile = (epaper_lut_profile_t)rtc_state.partial_profile;
+        
+        // 離開深度睡眠只需要硬體重置 (暫存器回到預設值，RAM 保留)
+        gpio_set_level(PIN_RST, 0);
+        vTaskDelay(pdMS_TO_TICKS(2));
+        gpio_set_level(PIN_RST, 1);
+        epaper_wait_busy();
+        
+        epaper_send_sequence(epaper, init_config_seq, sizeof(init_config_seq));
+        
+        // 從面板讀回畫面，雜湊相符時 framebuffer 與面板同步，DRAW 可以直接疊加在舊畫面上
+        epaper->framebuffer_synced = epaper_read_frame(epaper);
+        if (!epaper->framebuffer_synced) {
+            ESP_LOGW(TAG, "Panel RAM readback does not match saved hash, waiting for full update");
+            memset(epaper->framebuffer, 0xFF, EPAPER_BUFFER_SIZE);
+        }
+        
+        epaper->initialized = true;
+        epaper->init_us = (uint32_t)(esp_timer_get_time() - init_start_us);
+        ESP_LOGI(TAG, "E-Paper warm start completed in %lu us (wake to first SPI: %lu us, hash=0x%08lX)",
+                 epaper->init_us, epaper->wake_to_spi_us, epaper->frame_hash);
+        return ESP_OK;
+    }
+    
     memset(epaper->framebuffer, 0xFF, EPAPER_BUFFER_SIZE);  // 初始化為白色
+    epaper->frame_hash = 0;  // 面板上目前顯示的內容未知
+    epaper->prev_ram_valid = false;
+    epaper->full_profile = EPAPER_LUT_FAST_FULL;
+    epaper->partial_profile = EPAPER_LUT_FAST_PARTIAL;
     
     // 硬體重置
     epaper_reset();
@@ -225,33 +480,10 @@ esp_err_t epaper_init(epaper_t *epaper)
     epaper_send_command(epaper, 0x12);  // SWRESET
     vTaskDelay(pdMS_TO_TICKS(10));
     
-    // Temperature sensor control
-    epaper_send_command(epaper, 0x18);
-    epaper_send_data(epaper, 0x80);
-    
-    // Boost soft start configuration
-    epaper_send_command(epaper, 0x0C);
-    epaper_send_data(epaper, 0xAE);
-    epaper_send_data(epaper, 0xC7);
-    epaper_send_data(epaper, 0xC3);
-    epaper_send_data(epaper, 0xC0);
-    epaper_send_data(epaper, 0x80);
-    
-    // Driver output control (gates)
-    epaper_send_command(epaper, 0x01);
-    epaper_send_data(epaper, (EPAPER_HEIGHT - 1) % 256);      // A0-A7
-    epaper_send_data(epaper, (EPAPER_HEIGHT - 1) / 256);      // A8-A9
-    epaper_send_data(epaper, 0x02);                           // SM (interlaced)
-    
-    // Border waveform control
-    epaper_send_command(epaper, 0x3C);
-    epaper_send_data(epaper, 0x01);
+    // Temperature sensor, booster, gates, border, data entry mode
+    epaper_send_sequence(epaper, init_config_seq, sizeof(init_config_seq));
     
     // Set initial RAM area (full screen)
-    // Data entry mode: X increment, Y decrement (reversed)
-    epaper_send_command(epaper, 0x11);
-    epaper_send_data(epaper, 0x01);
-    
     // Set X range [0, WIDTH-1]
     epaper_send_command(epaper, 0x44);
     epaper_send_data(epaper, 0);
@@ -277,7 +509,9 @@ esp_err_t epaper_init(epaper_t *epaper)
     epaper_send_data(epaper, (EPAPER_HEIGHT - 1) / 256);
     
     epaper->initialized = true;
-    ESP_LOGI(TAG, "E-Paper initialization completed successfully");
+    epaper->init_us = (uint32_t)(esp_timer_get_time() - init_start_us);
+    ESP_LOGI(TAG, "E-Paper initialization completed in %lu us (wake to first SPI: %lu us)",
+             epaper->init_us, epaper->wake_to_spi_us);
     
     return ESP_OK;
 }
@@ -307,311 +541,1778 @@ esp_err_t epaper_deinit(epaper_t *epaper)
 
 /**
  * 進入深度睡眠模式
+ * 
+ * 使用 mode 1 保留面板 RAM，並把驅動狀態存入 RTC 記憶體，
+ * ESP32 深度睡眠喚醒後 epaper_init() 會走暖啟動流程
  */
 void epaper_sleep(epaper_t *epaper)
 {
-    epaper_send_command(epaper, CMD_DEEP_SLEEP);
-    epaper_send_data(epaper, 0xA5);
-    ESP_LOGI(TAG, "E-Paper entering deep sleep mode");
+    epaper_send_command(epaper, SSD_DEEP_SLEEP);
+    epaper_send_data(epaper, SSD_DEEP_SLEEP_MODE1);
+    
+    rtc_state.frame_hash = epaper->frame_hash;
+    rtc_state.prev_ram_valid = epaper->prev_ram_valid;
+    rtc_state.full_profile = (uint8_t)epaper->full_profile;
+    rtc_state.partial_profile = (uint8_t)epaper->partial_profile;
+    rtc_state.magic = EPAPER_RTC_MAGIC;
+    
+    // 睡眠期間保持 RST 為高電位，避免面板被重置
+    gpio_hold_en(PIN_RST);
+    gpio_deep_sleep_hold_en();
+    
+    ESP_LOGI(TAG, "E-Paper entering deep sleep mode (hash=0x%08lX)", epaper->frame_hash);
 }
 
 // ============================================
-// Framebuffer 操作函數
+// 畫面雜湊函數
 // ============================================
 
 /**
- * 設定單個像素
+ * 累加計算 FNV-1a 雜湊
+ * 可分段呼叫：第一段傳入 EPAPER_HASH_SEED，之後傳入上一段的結果
  */
-void epaper_set_pixel(epaper_t *epaper, uint16_t x, uint16_t y, uint8_t color)
+uint32_t epaper_hash_update(uint32_t hash, const uint8_t *data, size_t len)
 {
-    if (x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) {
-        return;
-    }
-    
-    uint32_t addr = (y * EPAPER_WIDTH + x) / 8;
-    uint8_t bit = 7 - (x % 8);
-    
-    if (color == COLOR_BLACK) {
-        epaper->framebuffer[addr] &= ~(1 << bit);
-    } else {
-        epaper->framebuffer[addr] |= (1 << bit);
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 0x01000193u;
     }
+    return hash;
 }
 
+// ============================================
+// Viewport 與裁切堆疊
+// ============================================
+//
+// 所有繪圖函數的座標都相對於目前 viewport 的原點，並裁切到目前的裁切矩形。
+// 公開函數先把座標換算成面板座標，之後的 span / 像素寫入只和裁切矩形比較一次，
+// 內層迴圈不再逐像素檢查邊界。
+
 /**
- * 取得單個像素
+ * 回到整個面板 (原點 0, 0，裁切到面板範圍) 並清空堆疊
  */
-uint8_t epaper_get_pixel(epaper_t *epaper, uint16_t x, uint16_t y)
+void epaper_reset_viewport(epaper_t *epaper)
 {
-    if (x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) {
-        return COLOR_WHITE;
-    }
-    
-    uint32_t addr = (y * EPAPER_WIDTH + x) / 8;
-    uint8_t bit = 7 - (x % 8);
-    
-    return (epaper->framebuffer[addr] & (1 << bit)) ? COLOR_WHITE : COLOR_BLACK;
+    epaper->view.ox = 0;
+    epaper->view.oy = 0;
+    epaper->view.clip.x0 = 0;
+    epaper->view.clip.y0 = 0;
+    epaper->view.clip.x1 = EPAPER_WIDTH - 1;
+    epaper->view.clip.y1 = EPAPER_HEIGHT - 1;
+    epaper->view_depth = 0;
 }
 
 /**
- * 填充矩形區域
+ * 將目前座標系中的矩形換算成面板座標，並與裁切矩形取交集
+ * 可用來取得 widget 實際會被繪製的部分更新區域
+ *
+ * @return 交集為空時回傳 false (out 設為空矩形)
  */
-void epaper_fill_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color)
+bool epaper_clip_rect(const epaper_t *epaper, int32_t x, int32_t y, int32_t w, int32_t h, epaper_rect_t *out)
 {
-    for (uint16_t j = 0; j < h; j++) {
-        for (uint16_t i = 0; i < w; i++) {
-            epaper_set_pixel(epaper, x + i, y + j, color);
-        }
+    const epaper_rect_t *clip = &epaper->view.clip;
+    int32_t x0 = x + epaper->view.ox;
+    int32_t y0 = y + epaper->view.oy;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+
+    if (x0 < clip->x0) x0 = clip->x0;
+    if (y0 < clip->y0) y0 = clip->y0;
+    if (x1 > clip->x1) x1 = clip->x1;
+    if (y1 > clip->y1) y1 = clip->y1;
+
+    if (w <= 0 || h <= 0 || x0 > x1 || y0 > y1) {
+        out->x0 = 0;
+        out->y0 = 0;
+        out->x1 = -1;
+        out->y1 = -1;
+        return false;
     }
+
+    out->x0 = (int16_t)x0;
+    out->y0 = (int16_t)y0;
+    out->x1 = (int16_t)x1;
+    out->y1 = (int16_t)y1;
+    return true;
 }
 
-/**
- * 繪製矩形邊框
- */
-void epaper_draw_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color)
+static esp_err_t push_view(epaper_t *epaper, int16_t x, int16_t y, uint16_t w, uint16_t h, bool move_origin)
 {
-    // 上下邊
-    for (uint16_t i = 0; i < w; i++) {
-        epaper_set_pixel(epaper, x + i, y, color);
-        epaper_set_pixel(epaper, x + i, y + h - 1, color);
+    if (epaper->view_depth >= EPAPER_VIEW_DEPTH) {
+        ESP_LOGE(TAG, "Viewport stack full (%d levels)", EPAPER_VIEW_DEPTH);
+        return ESP_ERR_NO_MEM;
     }
-    
-    // 左右邊
-    for (uint16_t j = 0; j < h; j++) {
-        epaper_set_pixel(epaper, x, y + j, color);
-        epaper_set_pixel(epaper, x + w - 1, y + j, color);
+
+    // 交集為空時裁切矩形也是空的：pop 之前什麼都不會畫
+    epaper_rect_t clip;
+    epaper_clip_rect(epaper, x, y, w, h, &clip);
+
+    epaper->view_stack[epaper->view_depth++] = epaper->view;
+    if (move_origin) {
+        epaper->view.ox += x;
+        epaper->view.oy += y;
     }
+    epaper->view.clip = clip;
+    return ESP_OK;
 }
 
-// ============================================
-// 顯示更新函數
-// ============================================
-
 /**
- * 清除螢幕
+ * 進入 widget 區域：原點移到 (x, y)，並裁切到 w x h (與目前的裁切矩形取交集)
+ * x, y 相對於目前的原點
+ *
+ * @return ESP_ERR_NO_MEM 堆疊已滿 (EPAPER_VIEW_DEPTH 層)
  */
-void epaper_clear_screen(epaper_t *epaper, uint8_t color)
+esp_err_t epaper_push_viewport(epaper_t *epaper, int16_t x, int16_t y, uint16_t w, uint16_t h)
 {
-    memset(epaper->framebuffer, color, EPAPER_BUFFER_SIZE);
+    return push_view(epaper, x, y, w, h, true);
 }
 
 /**
- * 全螢幕更新 (參考 GxEPD2)
+ * 只縮小裁切矩形，原點不變
  */
-void epaper_display_full(epaper_t *epaper)
+esp_err_t epaper_push_clip(epaper_t *epaper, int16_t x, int16_t y, uint16_t w, uint16_t h)
 {
-    ESP_LOGI(TAG, "Starting full display update...");
-    
-    // Write to "previous" buffer (0x26)
-    epaper_send_command(epaper, 0x26);
-    epaper_send_data_bulk(epaper, epaper->framebuffer, EPAPER_BUFFER_SIZE);
-    
-    // Write to "current" buffer (0x24)
-    epaper_send_command(epaper, 0x24);
-    epaper_send_data_bulk(epaper, epaper->framebuffer, EPAPER_BUFFER_SIZE);
-    
-    // Power on and update
-    epaper_send_command(epaper, 0x21);  // Display Update Control
-    epaper_send_data(epaper, 0x40);     // Bypass RED as 0
-    epaper_send_data(epaper, 0x00);     // Single chip application
-    
-    // Use fast update if available
-    epaper_send_command(epaper, 0x1A);  // Write to temperature register
-    epaper_send_data(epaper, 0x5A);     // Fast update temperature
-    
-    epaper_send_command(epaper, 0x22);  // Display Update Sequence
-    epaper_send_data(epaper, 0xd7);     // Fast refresh sequence
-    
-    epaper_send_command(epaper, 0x20);  // Master Activation
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
-    epaper_wait_busy();
-    ESP_LOGI(TAG, "Full display update completed");
+    return push_view(epaper, x, y, w, h, false);
 }
 
 /**
- * 部分更新 (參考 GxEPD2)
+ * 回到上一層 viewport / 裁切矩形
  */
-void epaper_display_partial(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+void epaper_pop_viewport(epaper_t *epaper)
 {
-    ESP_LOGI(TAG, "Starting partial update: x=%d, y=%d, w=%d, h=%d", x, y, w, h);
-    
-    // Make x, w multiple of 8 (byte boundary)
-    w += x % 8;
-    x -= x % 8;
-    w = (w + 7) & ~7;
-    
-    // Limit to screen bounds
-    if (x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) return;
-    if (x + w > EPAPER_WIDTH) w = EPAPER_WIDTH - x;
-    if (y + h > EPAPER_HEIGHT) h = EPAPER_HEIGHT - y;
-    
-    // Set partial RAM area (Y reversed for this display)
-    uint16_t y_reversed = EPAPER_HEIGHT - y - h;
-    
-    // Data entry mode: X increment, Y decrement (reversed)
-    epaper_send_command(epaper, 0x11);
-    epaper_send_data(epaper, 0x01);
-    
-    // Set X range
-    epaper_send_command(epaper, 0x44);
-    epaper_send_data(epaper, x % 256);
-    epaper_send_data(epaper, x / 256);
-    epaper_send_data(epaper, (x + w - 1) % 256);
-    epaper_send_data(epaper, (x + w - 1) / 256);
-    
-    // Set Y range (reversed)
-    epaper_send_command(epaper, 0x45);
-    epaper_send_data(epaper, (y_reversed + h - 1) % 256);
-    epaper_send_data(epaper, (y_reversed + h - 1) / 256);
-    epaper_send_data(epaper, y_reversed % 256);
-    epaper_send_data(epaper, y_reversed / 256);
-    
-    // Set X counter
-    epaper_send_command(epaper, 0x4E);
-    epaper_send_data(epaper, x % 256);
-    epaper_send_data(epaper, x / 256);
-    
-    // Set Y counter (reversed)
-    epaper_send_command(epaper, 0x4F);
-    epaper_send_data(epaper, (y_reversed + h - 1) % 256);
-    epaper_send_data(epaper, (y_reversed + h - 1) / 256);
-    
-    // Write data to BOTH previous buffer (0x26) and current buffer (0x24)
-    // This prevents ghosting from old data in the previous buffer
-    
-    // Write to previous buffer first
-    epaper_send_command(epaper, 0x26);
-    for (uint16_t j = 0; j < h; j++) {
-        uint16_t row = y + j;
-        uint16_t start_byte = (row * EPAPER_WIDTH + x) / 8;
-        uint16_t byte_count = w / 8;
-        epaper_send_data_bulk(epaper, &epaper->framebuffer[start_byte], byte_count);
-    }
-    
-    // Reset counters for current buffer write
-    epaper_send_command(epaper, 0x4E);
-    epaper_send_data(epaper, x % 256);
-    epaper_send_data(epaper, x / 256);
-    
-    epaper_send_command(epaper, 0x4F);
-    epaper_send_data(epaper, (y_reversed + h - 1) % 256);
-    epaper_send_data(epaper, (y_reversed + h - 1) / 256);
-    
-    // Write to current buffer (0x24)
-    epaper_send_command(epaper, 0x24);
-    
-    // Send partial region data
-    for (uint16_t j = 0; j < h; j++) {
-        uint16_t row = y + j;
-        uint16_t start_byte = (row * EPAPER_WIDTH + x) / 8;
-        uint16_t byte_count = w / 8;
-        epaper_send_data_bulk(epaper, &epaper->framebuffer[start_byte], byte_count);
+    if (epaper->view_depth == 0) {
+        ESP_LOGW(TAG, "Viewport stack underflow");
+        return;
     }
-    
-    // Power on and partial update
-    epaper_send_command(epaper, 0x21);  // Display Update Control
-    epaper_send_data(epaper, 0x00);     // RED normal
-    epaper_send_data(epaper, 0x00);     // Single chip application
-    
-    epaper_send_command(epaper, 0x22);  // Display Update Sequence
-    epaper_send_data(epaper, 0xfc);     // Partial update sequence
-    
-    epaper_send_command(epaper, 0x20);  // Master Activation
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
-    epaper_wait_busy();
-    
-    ESP_LOGI(TAG, "Partial update completed");
+    epaper->view = epaper->view_stack[--epaper->view_depth];
+}
+
+static inline int32_t screen_x(const epaper_t *epaper, int32_t x)
+{
+    return x + epaper->view.ox;
+}
+
+static inline int32_t screen_y(const epaper_t *epaper, int32_t y)
+{
+    return y + epaper->view.oy;
 }
 
 // ============================================
-// 文字繪製函數
+// 基本圖形 (以 byte span 寫入 framebuffer)
 // ============================================
+//
+// 以下 static 函數都使用面板座標，並裁切到 epaper->view.clip
 
 /**
- * 繪製 8x16 ASCII 字符
+ * 寫入單個像素
  */
-void epaper_draw_char_8x16(epaper_t *epaper, uint16_t x, uint16_t y, char c, uint8_t color)
+static inline void plot(epaper_t *epaper, int32_t x, int32_t y, uint8_t color)
 {
-    if (x + 8 > EPAPER_WIDTH || y + 16 > EPAPER_HEIGHT) {
+    const epaper_rect_t *clip = &epaper->view.clip;
+    if (x < clip->x0 || y < clip->y0 || x > clip->x1 || y > clip->y1) {
         return;
     }
-    
-    // 使用新的字體 API
-    const uint8_t *font_data = get_ascii_font(c);
-    
-    for (int row = 0; row < 16; row++) {
-        uint8_t line = font_data[row];
-        for (int col = 0; col < 8; col++) {
-            if (line & (0x80 >> col)) {
-                epaper_set_pixel(epaper, x + col, y + row, color);
-            }
-        }
+
+    uint8_t *p = epaper->framebuffer + (uint32_t)y * EPAPER_ROW_BYTES + (x >> 3);
+    uint8_t mask = 0x80 >> (x & 7);
+    if (color == COLOR_BLACK) {
+        *p &= ~mask;
+    } else {
+        *p |= mask;
     }
 }
 
 /**
- * 繪製 16x16 中文字符
+ * 填滿一行中 [x0, x1] 的像素
+ * 兩端不足一個 byte 的部分用遮罩，中間整段 memset
  */
-void epaper_draw_chinese_16x16(epaper_t *epaper, uint16_t x, uint16_t y, const char *utf8_char, uint8_t color)
+static void fill_span(epaper_t *epaper, int32_t x0, int32_t x1, int32_t y, uint8_t color)
 {
-    if (x + 16 > EPAPER_WIDTH || y + 16 > EPAPER_HEIGHT) {
+    if (x0 > x1) {
+        int32_t t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    const epaper_rect_t *clip = &epaper->view.clip;
+    if (y < clip->y0 || y > clip->y1 || x1 < clip->x0 || x0 > clip->x1) {
         return;
     }
-    
-    const uint8_t *font_data = get_chinese_font(utf8_char);
+    if (x0 < clip->x0) {
+        x0 = clip->x0;
+    }
+    if (x1 > clip->x1) {
+        x1 = clip->x1;
+    }
+
+    uint8_t *row = epaper->framebuffer + (uint32_t)y * EPAPER_ROW_BYTES;
+    int32_t b0 = x0 >> 3;
+    int32_t b1 = x1 >> 3;
+    uint8_t m0 = 0xFF >> (x0 & 7);
+    uint8_t m1 = (uint8_t)(0xFF << (7 - (x1 & 7)));
+    bool black = (color == COLOR_BLACK);
+
+    if (b0 == b1) {
+        m0 &= m1;
+        row[b0] = black ? (row[b0] & ~m0) : (row[b0] | m0);
+        return;
+    }
+
+    row[b0] = black ? (row[b0] & ~m0) : (row[b0] | m0);
+    memset(&row[b0 + 1], black ? COLOR_BLACK : COLOR_WHITE, b1 - b0 - 1);
+    row[b1] = black ? (row[b1] & ~m1) : (row[b1] | m1);
+}
+
+/**
+ * 填滿一列中 [y0, y1] 的像素 (同一個位元遮罩，每行前進 EPAPER_ROW_BYTES)
+ */
+static void fill_vspan(epaper_t *epaper, int32_t x, int32_t y0, int32_t y1, uint8_t color)
+{
+    if (y0 > y1) {
+        int32_t t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    const epaper_rect_t *clip = &epaper->view.clip;
+    if (x < clip->x0 || x > clip->x1 || y1 < clip->y0 || y0 > clip->y1) {
+        return;
+    }
+    if (y0 < clip->y0) {
+        y0 = clip->y0;
+    }
+    if (y1 > clip->y1) {
+        y1 = clip->y1;
+    }
+
+    uint8_t *p = epaper->framebuffer + (uint32_t)y0 * EPAPER_ROW_BYTES + (x >> 3);
+    uint8_t mask = 0x80 >> (x & 7);
+    if (color == COLOR_BLACK) {
+        for (int32_t y = y0; y <= y1; y++, p += EPAPER_ROW_BYTES) {
+            *p &= ~mask;
+        }
+    } else {
+        for (int32_t y = y0; y <= y1; y++, p += EPAPER_ROW_BYTES) {
+            *p |= mask;
+        }
+    }
+}
+
+/**
+ * 設定單個像素
+ */
+void epaper_set_pixel(epaper_t *epaper, uint16_t x, uint16_t y, uint8_t color)
+{
+    plot(epaper, screen_x(epaper, x), screen_y(epaper, y), color);
+}
+
+/**
+ * 取得單個像素 (不受裁切矩形限制，面板外回傳白色)
+ */
+uint8_t epaper_get_pixel(epaper_t *epaper, uint16_t x, uint16_t y)
+{
+    int32_t sx = screen_x(epaper, x);
+    int32_t sy = screen_y(epaper, y);
+    if (sx < 0 || sy < 0 || sx >= EPAPER_WIDTH || sy >= EPAPER_HEIGHT) {
+        return COLOR_WHITE;
+    }
+    
+    uint8_t bits = epaper->framebuffer[(uint32_t)sy * EPAPER_ROW_BYTES + (sx >> 3)];
+    return (bits & (0x80 >> (sx & 7))) ? COLOR_WHITE : COLOR_BLACK;
+}
+
+/**
+ * 繪製水平線 (w 像素)
+ */
+void epaper_draw_hline(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint8_t color)
+{
+    if (w > 0) {
+        int32_t sx = screen_x(epaper, x);
+        fill_span(epaper, sx, sx + w - 1, screen_y(epaper, y), color);
+    }
+}
+
+/**
+ * 繪製垂直線 (h 像素)
+ */
+void epaper_draw_vline(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t h, uint8_t color)
+{
+    if (h > 0) {
+        int32_t sy = screen_y(epaper, y);
+        fill_vspan(epaper, screen_x(epaper, x), sy, sy + h - 1, color);
+    }
+}
+
+/**
+ * 填充矩形區域
+ */
+void epaper_fill_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color)
+{
+    epaper_rect_t r;
+    if (!epaper_clip_rect(epaper, x, y, w, h, &r)) {
+        return;
+    }
+
+    for (int32_t row = r.y0; row <= r.y1; row++) {
+        fill_span(epaper, r.x0, r.x1, row, color);
+    }
+}
+
+/**
+ * 以 color 填滿目前的整個裁切矩形 (清除 widget 區域)
+ */
+void epaper_fill_clip(epaper_t *epaper, uint8_t color)
+{
+    const epaper_rect_t *clip = &epaper->view.clip;
+    for (int32_t row = clip->y0; row <= clip->y1; row++) {
+        fill_span(epaper, clip->x0, clip->x1, row, color);
+    }
+}
+
+/**
+ * 繪製矩形邊框
+ */
+void epaper_draw_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+
+    int32_t x0 = screen_x(epaper, x);
+    int32_t y0 = screen_y(epaper, y);
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+
+    // 上下邊
+    fill_span(epaper, x0, x1, y0, color);
+    fill_span(epaper, x0, x1, y1, color);
+
+    // 左右邊
+    fill_vspan(epaper, x0, y0, y1, color);
+    fill_vspan(epaper, x1, y0, y1, color);
+}
+
+/**
+ * 繪製直線
+ * 水平線與垂直線走 span 路徑，其餘用 Bresenham；
+ * 線段與裁切矩形的交集是連續的一段，離開裁切矩形後就停止
+ */
+static void draw_line(epaper_t *epaper, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t color)
+{
+    if (y0 == y1) {
+        fill_span(epaper, x0, x1, y0, color);
+        return;
+    }
+    if (x0 == x1) {
+        fill_vspan(epaper, x0, y0, y1, color);
+        return;
+    }
+
+    // 兩端都在裁切矩形同一側之外
+    const epaper_rect_t *clip = &epaper->view.clip;
+    if ((x0 < clip->x0 && x1 < clip->x0) || (y0 < clip->y0 && y1 < clip->y0) ||
+        (x0 > clip->x1 && x1 > clip->x1) || (y0 > clip->y1 && y1 > clip->y1)) {
+        return;
+    }
+
+    int32_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int32_t dy = (y1 > y0) ? -(y1 - y0) : -(y0 - y1);
+    int32_t sx = (x0 < x1) ? 1 : -1;
+    int32_t sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx + dy;
+    int32_t x = x0;
+    int32_t y = y0;
+    bool entered = false;
+    bool black = (color == COLOR_BLACK);
+
+    while (1) {
+        if (x >= clip->x0 && y >= clip->y0 && x <= clip->x1 && y <= clip->y1) {
+            uint8_t *p = epaper->framebuffer + (uint32_t)y * EPAPER_ROW_BYTES + (x >> 3);
+            uint8_t mask = 0x80 >> (x & 7);
+            *p = black ? (*p & ~mask) : (*p | mask);
+            entered = true;
+        } else if (entered) {
+            break;
+        }
+        if (x == x1 && y == y1) {
+            break;
+        }
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+/**
+ * 繪製直線
+ */
+void epaper_draw_line(epaper_t *epaper, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t color)
+{
+    draw_line(epaper, screen_x(epaper, x0), screen_y(epaper, y0),
+              screen_x(epaper, x1), screen_y(epaper, y1), color);
+}
+
+/**
+ * 中點圓演算法：以 (l, t) (r, b) 四個角落為圓心畫四分之一圓
+ * 圓形時四個圓心重合；圓角矩形時分別是四個角
+ */
+static void draw_corners(epaper_t *epaper, int32_t l, int32_t t, int32_t r, int32_t b,
+                         int32_t radius, uint8_t color)
+{
+    int32_t px = radius;
+    int32_t py = 0;
+    int32_t err = 1 - radius;
+
+    while (px >= py) {
+        plot(epaper, r + px, t - py, color);
+        plot(epaper, r + py, t - px, color);
+        plot(epaper, r + px, b + py, color);
+        plot(epaper, r + py, b + px, color);
+        plot(epaper, l - px, b + py, color);
+        plot(epaper, l - py, b + px, color);
+        plot(epaper, l - px, t - py, color);
+        plot(epaper, l - py, t - px, color);
+
+        py++;
+        if (err < 0) {
+            err += 2 * py + 1;
+        } else {
+            px--;
+            err += 2 * (py - px) + 1;
+        }
+    }
+}
+
+/**
+ * 填滿四個角落的四分之一圓，每個 (px, py) 對應上下各兩條 span
+ * 中間 t..b 的部分由呼叫者填滿
+ */
+static void fill_corners(epaper_t *epaper, int32_t l, int32_t t, int32_t r, int32_t b,
+                         int32_t radius, uint8_t color)
+{
+    int32_t px = radius;
+    int32_t py = 0;
+    int32_t err = 1 - radius;
+
+    while (px >= py) {
+        fill_span(epaper, l - px, r + px, t - py, color);
+        fill_span(epaper, l - px, r + px, b + py, color);
+        fill_span(epaper, l - py, r + py, t - px, color);
+        fill_span(epaper, l - py, r + py, b + px, color);
+
+        py++;
+        if (err < 0) {
+            err += 2 * py + 1;
+        } else {
+            px--;
+            err += 2 * (py - px) + 1;
+        }
+    }
+}
+
+/**
+ * 繪製圓形外框 (中點圓演算法)
+ */
+void epaper_draw_circle(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r, uint8_t color)
+{
+    int32_t sx = screen_x(epaper, cx);
+    int32_t sy = screen_y(epaper, cy);
+    draw_corners(epaper, sx, sy, sx, sy, r, color);
+}
+
+/**
+ * 填充圓形
+ */
+void epaper_fill_circle(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r, uint8_t color)
+{
+    int32_t sx = screen_x(epaper, cx);
+    int32_t sy = screen_y(epaper, cy);
+    fill_corners(epaper, sx, sy, sx, sy, r, color);
+}
+
+/**
+ * 繪製圓弧
+ * 角度以度為單位，0 度在右方 (3 點鐘)，順時針遞增；從 start_deg 順時針畫到 end_deg
+ * 
+ * 沿用中點圓的點，只保留落在起訖兩個方向之間的點 (以外積判斷，不需逐點三角函數)
+ */
+void epaper_draw_arc(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r,
+                     int16_t start_deg, int16_t end_deg, uint8_t color)
+{
+    int32_t sweep = ((int32_t)end_deg - start_deg) % 360;
+    if (sweep < 0) {
+        sweep += 360;
+    }
+    if (sweep == 0) {
+        if (start_deg != end_deg) {
+            epaper_draw_circle(epaper, cx, cy, r, color);
+        }
+        return;
+    }
+
+    // 起訖方向的單位向量 (Q12 定點數，y 軸向下所以順時針為正)
+    const float rad = 3.14159265f / 180.0f;
+    int32_t sx = (int32_t)lroundf(cosf(start_deg * rad) * 4096.0f);
+    int32_t sy = (int32_t)lroundf(sinf(start_deg * rad) * 4096.0f);
+    int32_t ex = (int32_t)lroundf(cosf(end_deg * rad) * 4096.0f);
+    int32_t ey = (int32_t)lroundf(sinf(end_deg * rad) * 4096.0f);
+
+    int32_t px = r;
+    int32_t py = 0;
+    int32_t err = 1 - (int32_t)r;
+
+    while (px >= py) {
+        const int32_t pts[8][2] = {
+            {  px,  py }, {  py,  px }, { -py,  px }, { -px,  py },
+            { -px, -py }, { -py, -px }, {  py, -px }, {  px, -py },
+        };
+        for (int i = 0; i < 8; i++) {
+            int32_t dx = pts[i][0];
+            int32_t dy = pts[i][1];
+            // a x b > 0 表示 b 在 a 的順時針方向
+            int32_t s_cross = sx * dy - sy * dx;
+            int32_t e_cross = dx * ey - dy * ex;
+            bool in_arc;
+            if (sweep <= 180) {
+                in_arc = (s_cross >= 0) && (e_cross >= 0);
+            } else {
+                in_arc = !((s_cross < 0) && (e_cross < 0));
+            }
+            if (in_arc) {
+                plot(epaper, screen_x(epaper, cx + dx), screen_y(epaper, cy + dy), color);
+            }
+        }
+
+        py++;
+        if (err < 0) {
+            err += 2 * py + 1;
+        } else {
+            px--;
+            err += 2 * (py - px) + 1;
+        }
+    }
+}
+
+/**
+ * 圓角半徑不可超過短邊的一半
+ */
+static uint16_t clamp_radius(uint16_t w, uint16_t h, uint16_t r)
+{
+    uint16_t max_r = ((w < h) ? w : h) / 2;
+    return (r > max_r) ? max_r : r;
+}
+
+/**
+ * 繪製圓角矩形邊框
+ */
+void epaper_draw_round_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            uint16_t r, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+    r = clamp_radius(w, h, r);
+    if (r == 0) {
+        epaper_draw_rect(epaper, x, y, w, h, color);
+        return;
+    }
+
+    int32_t x0 = screen_x(epaper, x);
+    int32_t y0 = screen_y(epaper, y);
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+
+    fill_span(epaper, x0 + r, x1 - r, y0, color);
+    fill_span(epaper, x0 + r, x1 - r, y1, color);
+    fill_vspan(epaper, x0, y0 + r, y1 - r, color);
+    fill_vspan(epaper, x1, y0 + r, y1 - r, color);
+    draw_corners(epaper, x0 + r, y0 + r, x1 - r, y1 - r, r, color);
+}
+
+/**
+ * 填充圓角矩形
+ */
+void epaper_fill_round_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            uint16_t r, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+    r = clamp_radius(w, h, r);
+
+    int32_t x0 = screen_x(epaper, x);
+    int32_t y0 = screen_y(epaper, y);
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+
+    // 中間整行寬度的部分
+    int32_t row_end = (y1 - r < epaper->view.clip.y1) ? y1 - r : epaper->view.clip.y1;
+    for (int32_t row = y0 + r; row <= row_end; row++) {
+        fill_span(epaper, x0, x1, row, color);
+    }
+    if (r > 0) {
+        fill_corners(epaper, x0 + r, y0 + r, x1 - r, y1 - r, r, color);
+    }
+}
+
+// ============================================
+// 多邊形 (edge table 掃描線填滿)
+// ============================================
+
+// 多邊形的一條邊：覆蓋 ya..yb-1 行 (以像素中心 y + 0.5 取樣)
+typedef struct {
+    int32_t ya;         // 上端點 (含)
+    int32_t yb;         // 下端點 (不含)
+    int32_t xa;
+    int32_t dx;         // 下端點 x - 上端點 x
+    int32_t dy;         // yb - ya (> 0)
+    int8_t dir;         // 原始方向：+1 向下、-1 向上 (non-zero 規則用)
+} poly_edge_t;
+
+// 一條邊與掃描線的交點
+typedef struct {
+    int32_t x;          // 交點右側第一個像素
+    int8_t dir;
+} poly_cross_t;
+
+// 掃描線工作區 (繪圖只在單一 task 中進行，不需重入)
+static poly_edge_t poly_edges[EPAPER_POLY_MAX_POINTS];
+static uint8_t poly_active[EPAPER_POLY_MAX_POINTS];
+static poly_cross_t poly_cross[EPAPER_POLY_MAX_POINTS];
+
+static inline int64_t ceil_div(int64_t a, int64_t b)
+{
+    // b > 0
+    return (a >= 0) ? (a + b - 1) / b : -((-a) / b);
+}
+
+/**
+ * 邊在第 y 行像素中心的交點，回傳中心落在交點右側的第一個像素
+ */
+static int32_t edge_cross(const poly_edge_t *e, int32_t y)
+{
+    // x = xa + (y + 0.5 - ya) * dx / dy，像素 i 的中心是 i + 0.5
+    int64_t num = (int64_t)(2 * (y - e->ya) + 1) * e->dx + (int64_t)2 * e->xa * e->dy - e->dy;
+    return (int32_t)ceil_div(num, (int64_t)2 * e->dy);
+}
+
+/**
+ * 填充多邊形
+ * 頂點依序相連並自動封閉；像素中心落在多邊形內的像素才填滿，
+ * 相鄰的多邊形共用的邊不會重複繪製；只掃描裁切矩形內的行
+ *
+ * @param rule  EPAPER_FILL_EVEN_ODD 奇偶規則 / EPAPER_FILL_NONZERO 非零環繞規則
+ * @return ESP_ERR_INVALID_ARG 頂點數少於 3 或超過 EPAPER_POLY_MAX_POINTS
+ */
+esp_err_t epaper_fill_polygon(epaper_t *epaper, const epaper_point_t *points, uint16_t count,
+                              epaper_fill_rule_t rule, uint8_t color)
+{
+    if (points == NULL || count < 3 || count > EPAPER_POLY_MAX_POINTS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 建立 edge table (略過水平邊)，依上端點排序
+    int n = 0;
+    int32_t ymin = INT32_MAX;
+    int32_t ymax = INT32_MIN;
+    for (uint16_t i = 0; i < count; i++) {
+        const epaper_point_t *p0 = &points[i];
+        const epaper_point_t *p1 = &points[(i + 1) % count];
+        if (p0->y == p1->y) {
+            continue;
+        }
+
+        // 邊在面板座標中
+        poly_edge_t e;
+        if (p0->y < p1->y) {
+            e.ya = screen_y(epaper, p0->y);
+            e.yb = screen_y(epaper, p1->y);
+            e.xa = screen_x(epaper, p0->x);
+            e.dx = p1->x - p0->x;
+            e.dir = 1;
+        } else {
+            e.ya = screen_y(epaper, p1->y);
+            e.yb = screen_y(epaper, p0->y);
+            e.xa = screen_x(epaper, p1->x);
+            e.dx = p0->x - p1->x;
+            e.dir = -1;
+        }
+        e.dy = e.yb - e.ya;
+
+        int j = n++;
+        while (j > 0 && poly_edges[j - 1].ya > e.ya) {
+            poly_edges[j] = poly_edges[j - 1];
+            j--;
+        }
+        poly_edges[j] = e;
+
+        if (e.ya < ymin) ymin = e.ya;
+        if (e.yb > ymax) ymax = e.yb;
+    }
+    if (n == 0) {
+        return ESP_OK;
+    }
+
+    // 只掃描裁切矩形內的行
+    if (ymin < epaper->view.clip.y0) ymin = epaper->view.clip.y0;
+    if (ymax > epaper->view.clip.y1 + 1) ymax = epaper->view.clip.y1 + 1;
+
+    int next = 0;
+    int active = 0;
+    for (int32_t y = ymin; y < ymax; y++) {
+        // 加入從這一行 (或螢幕上方) 開始的邊
+        while (next < n && poly_edges[next].ya <= y) {
+            if (poly_edges[next].yb > y) {
+                poly_active[active++] = (uint8_t)next;
+            }
+            next++;
+        }
+
+        // 移除已結束的邊，計算其餘邊的交點 (插入排序：相鄰兩行的順序幾乎不變)
+        int crossings = 0;
+        int keep = 0;
+        for (int i = 0; i < active; i++) {
+            const poly_edge_t *e = &poly_edges[poly_active[i]];
+            if (e->yb <= y) {
+                continue;
+            }
+            poly_active[keep++] = poly_active[i];
+
+            poly_cross_t c = { .x = edge_cross(e, y), .dir = e->dir };
+            int j = crossings++;
+            while (j > 0 && poly_cross[j - 1].x > c.x) {
+                poly_cross[j] = poly_cross[j - 1];
+                j--;
+            }
+            poly_cross[j] = c;
+        }
+        active = keep;
+
+        // 交點之間填滿 [左交點, 右交點 - 1]
+        if (rule == EPAPER_FILL_NONZERO) {
+            int winding = 0;
+            int32_t start = 0;
+            for (int i = 0; i < crossings; i++) {
+                if (winding == 0) {
+                    start = poly_cross[i].x;
+                }
+                winding += poly_cross[i].dir;
+                if (winding == 0 && poly_cross[i].x > start) {
+                    fill_span(epaper, start, poly_cross[i].x - 1, y, color);
+                }
+            }
+        } else {
+            for (int i = 0; i + 1 < crossings; i += 2) {
+                if (poly_cross[i + 1].x > poly_cross[i].x) {
+                    fill_span(epaper, poly_cross[i].x, poly_cross[i + 1].x - 1, y, color);
+                }
+            }
+        }
+
+        if (active == 0 && next >= n) {
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * 繪製多邊形外框 (closed = false 時為折線，不連接最後一點與第一點)
+ */
+void epaper_draw_polygon(epaper_t *epaper, const epaper_point_t *points, uint16_t count,
+                         bool closed, uint8_t color)
+{
+    if (points == NULL || count == 0) {
+        return;
+    }
+    int32_t ox = epaper->view.ox;
+    int32_t oy = epaper->view.oy;
+    if (count == 1) {
+        plot(epaper, points[0].x + ox, points[0].y + oy, color);
+        return;
+    }
+
+    for (uint16_t i = 0; i + 1 < count; i++) {
+        draw_line(epaper, points[i].x + ox, points[i].y + oy,
+                  points[i + 1].x + ox, points[i + 1].y + oy, color);
+    }
+    if (closed && count > 2) {
+        draw_line(epaper, points[count - 1].x + ox, points[count - 1].y + oy,
+                  points[0].x + ox, points[0].y + oy, color);
+    }
+}
+
+/**
+ * 以面板座標繪製 1bpp 點陣圖，裁切到裁切矩形
+ * 
+ * 以整個 byte 為單位寫入 framebuffer：來源 byte 依 x % 8 拆到相鄰兩個目的 byte；
+ * 裁切矩形外的欄位先以遮罩清掉，所以寫入的 byte 一定在裁切矩形內
+ */
+static void blit(epaper_t *epaper, int32_t x, int32_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint8_t color)
+{
+    const epaper_rect_t *clip = &epaper->view.clip;
+    
+    // 可見的來源範圍：欄 c0..c1-1，行 r0..r1-1
+    int32_t c0 = (clip->x0 > x) ? clip->x0 - x : 0;
+    int32_t c1 = (clip->x1 - x + 1 < w) ? clip->x1 - x + 1 : w;
+    int32_t r0 = (clip->y0 > y) ? clip->y0 - y : 0;
+    int32_t r1 = (clip->y1 - y + 1 < h) ? clip->y1 - y + 1 : h;
+    if (c0 >= c1 || r0 >= r1) {
+        return;
+    }
+    
+    uint16_t stride = (w + 7) / 8;
+    int32_t i0 = c0 / 8;
+    int32_t i1 = (c1 - 1) / 8;
+    uint8_t first_mask = 0xFF >> (c0 % 8);
+    uint8_t last_mask = (uint8_t)(0xFF << (7 - (c1 - 1) % 8));
+    uint8_t shift = x & 7;
+    int32_t base = x >> 3;      // 來源第 0 個 byte 對應的目的 byte (可能為負，只會用到裁切矩形內的部分)
+    bool black = (color == COLOR_BLACK);
+    
+    for (int32_t row = r0; row < r1; row++) {
+        const uint8_t *src = bitmap + row * stride;
+        uint8_t *dst = epaper->framebuffer + (uint32_t)(y + row) * EPAPER_ROW_BYTES + base;
+        
+        for (int32_t i = i0; i <= i1; i++) {
+            uint8_t bits = src[i];
+            if (i == i0) {
+                bits &= first_mask;
+            }
+            if (i == i1) {
+                bits &= last_mask;
+            }
+            if (bits == 0) {
+                continue;
+            }
+            
+            uint8_t hi = bits >> shift;
+            uint8_t lo = shift ? (uint8_t)(bits << (8 - shift)) : 0;
+            if (black) {
+                if (hi) {
+                    dst[i] &= ~hi;
+                }
+                if (lo) {
+                    dst[i + 1] &= ~lo;
+                }
+            } else {
+                if (hi) {
+                    dst[i] |= hi;
+                }
+                if (lo) {
+                    dst[i + 1] |= lo;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * 繪製 1bpp 點陣圖 (MSB 在左，每行補齊到位元組邊界)
+ * 只繪製為 1 的位元，0 的位元保持透明；裁切矩形外的部分不繪製
+ */
+void epaper_draw_bitmap(epaper_t *epaper, uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint8_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+    blit(epaper, screen_x(epaper, x), screen_y(epaper, y), bitmap, w, h, color);
+}
+
+// 放大用的半位元組展開表：每個 bit 複製成 2 / 3 / 4 個 bit
+static const uint8_t expand_x2[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+static const uint16_t expand_x3[16] = {
+    0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+    0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF,
+};
+
+static const uint16_t expand_x4[16] = {
+    0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+    0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF,
+};
+
+/**
+ * 將一行點陣水平放大 scale 倍
+ * 
+ * @param out_bytes 輸出的 bytes 上限 (超出的部分捨棄)
+ */
+static void expand_row(const uint8_t *src, uint16_t w, uint8_t scale, uint8_t *out, uint16_t out_bytes)
+{
+    uint16_t src_bytes = (w + 7) / 8;
+    uint8_t last_mask = (uint8_t)(0xFF << ((8 - w % 8) % 8));
+    uint16_t o = 0;
+    
+    if (scale <= 4) {
+        // 查表：每個來源 byte 展開成 scale 個完整的 byte
+        for (uint16_t i = 0; i < src_bytes && o < out_bytes; i++) {
+            uint8_t b = (i == src_bytes - 1) ? (src[i] & last_mask) : src[i];
+            uint32_t e;
+            switch (scale) {
+                case 2:  e = ((uint32_t)expand_x2[b >> 4] << 8) | expand_x2[b & 0x0F]; break;
+                case 3:  e = ((uint32_t)expand_x3[b >> 4] << 12) | expand_x3[b & 0x0F]; break;
+                case 4:  e = ((uint32_t)expand_x4[b >> 4] << 16) | expand_x4[b & 0x0F]; break;
+                default: e = b; break;
+            }
+            for (int k = scale - 1; k >= 0 && o < out_bytes; k--) {
+                out[o++] = (uint8_t)(e >> (k * 8));
+            }
+        }
+        memset(out + o, 0, out_bytes - o);
+        return;
+    }
+    
+    // 更大的倍數：逐 bit 展開
+    memset(out, 0, out_bytes);
+    uint32_t limit = (uint32_t)out_bytes * 8;
+    for (uint16_t col = 0; col < w; col++) {
+        if (!(src[col / 8] & (0x80 >> (col % 8)))) {
+            continue;
+        }
+        for (uint32_t px = (uint32_t)col * scale; px < (uint32_t)(col + 1) * scale && px < limit; px++) {
+            out[px / 8] |= 0x80 >> (px % 8);
+        }
+    }
+}
+
+/**
+ * 取出 src 從第 bit_off 個 bit 開始的 nbits 個 bit，左對齊寫入 out
+ */
+static void extract_bits(const uint8_t *src, uint32_t bit_off, uint16_t nbits, uint8_t *out)
+{
+    uint16_t out_bytes = (nbits + 7) / 8;
+    const uint8_t *p = src + bit_off / 8;
+    uint8_t shift = bit_off % 8;
+    uint16_t src_bytes = (uint16_t)((bit_off % 8 + nbits + 7) / 8);
+    
+    for (uint16_t i = 0; i < out_bytes; i++) {
+        uint8_t b = (uint8_t)(p[i] << shift);
+        if (shift && i + 1 < src_bytes) {
+            b |= p[i + 1] >> (8 - shift);
+        }
+        out[i] = b;
+    }
+}
+
+/**
+ * 放大繪製 1bpp 點陣圖 (每個像素變成 scale x scale)
+ * 只展開裁切矩形內的欄：每一行先查表水平展開，再以 blit 重複畫 scale 行
+ */
+void epaper_draw_bitmap_scaled(epaper_t *epaper, uint16_t x, uint16_t y, const uint8_t *bitmap,
+                               uint16_t w, uint16_t h, uint8_t scale, uint8_t color)
+{
+    if (scale <= 1) {
+        epaper_draw_bitmap(epaper, x, y, bitmap, w, h, color);
+        return;
+    }
+    if (w == 0 || h == 0) {
+        return;
+    }
+    
+    const epaper_rect_t *clip = &epaper->view.clip;
+    int32_t sx = screen_x(epaper, x);
+    int32_t sy = screen_y(epaper, y);
+    
+    // 裁切矩形左側之外的來源欄整欄略過
+    int32_t skip = (clip->x0 > sx) ? (clip->x0 - sx) / scale : 0;
+    if (skip >= w) {
+        return;
+    }
+    int32_t dx = sx + skip * scale;
+    uint16_t src_w = w - (uint16_t)skip;
+    
+    // 展開的寬度不超過裁切矩形的右緣
+    int32_t vis_w = (int32_t)src_w * scale;
+    if (vis_w > clip->x1 - dx + 1) {
+        vis_w = clip->x1 - dx + 1;
+    }
+    if (vis_w <= 0) {
+        return;
+    }
+    src_w = (uint16_t)((vis_w + scale - 1) / scale);
+    
+    uint16_t out_bytes = (vis_w + 7) / 8;
+    uint16_t stride = (w + 7) / 8;
+    uint8_t src_row[EPAPER_ROW_BYTES + 1];
+    uint8_t row[EPAPER_ROW_BYTES + 2];
+    
+    for (uint16_t r = 0; r < h; r++) {
+        int32_t dy = sy + (int32_t)r * scale;
+        if (dy > clip->y1) {
+            break;
+        }
+        if (dy + scale <= clip->y0) {
+            continue;
+        }
+        const uint8_t *src = bitmap + r * stride;
+        if (skip > 0) {
+            extract_bits(src, skip, src_w, src_row);
+            src = src_row;
+        }
+        expand_row(src, src_w, scale, row, out_bytes);
+        for (uint8_t k = 0; k < scale; k++) {
+            blit(epaper, dx, dy + k, row, (uint16_t)vis_w, 1, color);
+        }
+    }
+}
+
+// ============================================
+// 區域移動 (捲動)
+// ============================================
+
+/**
+ * 將 src 一行中從第 bit_off 個像素開始的像素，搬到 tmp 中 [b0, b1] 這幾個 byte 的位置
+ * (tmp 的第 b 個 byte 對應 src 的第 8 * b - shift 個像素)；超出 src 一行的部分補 0
+ */
+static void shift_row(const uint8_t *src, int32_t shift, int32_t b0, int32_t b1, uint8_t *tmp)
+{
+    int32_t sb = b0 + ((-shift) >> 3);  // tmp[b0] 第一個像素所在的來源 byte (向下取整)
+    uint8_t sh = (uint8_t)((-shift) & 7);
+
+    for (int32_t b = b0; b <= b1; b++, sb++) {
+        uint8_t hi = (sb >= 0 && sb < EPAPER_ROW_BYTES) ? src[sb] : 0;
+        if (sh == 0) {
+            tmp[b] = hi;
+            continue;
+        }
+        uint8_t lo = (sb + 1 >= 0 && sb + 1 < EPAPER_ROW_BYTES) ? src[sb + 1] : 0;
+        tmp[b] = (uint8_t)((hi << sh) | (lo >> (8 - sh)));
+    }
+}
+
+/**
+ * 將區域內容平移 (dx, dy)，並以 fill 填滿移開後露出的部分
+ *
+ * 目的區域裁切到目前的裁切矩形：要在方框內捲動 (例如日誌視窗往上捲一行)，
+ * 先以 epaper_push_clip() 裁切到方框，移出方框的內容就會被捨棄。
+ * 每一行以 byte 為單位搬移：dx 為 8 的倍數時直接 memmove，否則先以位移合併到暫存行再寫回；
+ * 來源與目的重疊時依 dy 的方向決定逐行順序，所以可以原地搬移。
+ */
+void epaper_move_region(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        int16_t dx, int16_t dy, uint8_t fill)
+{
+    // 來源 S (面板座標，已裁切)
+    epaper_rect_t s;
+    if (!epaper_clip_rect(epaper, x, y, w, h, &s)) {
+        return;
+    }
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    // 平移後的來源 T = S + (dx, dy)，目的 D = T ∩ 裁切矩形
+    const epaper_rect_t *clip = &epaper->view.clip;
+    int32_t tx0 = s.x0 + dx;
+    int32_t ty0 = s.y0 + dy;
+    int32_t tx1 = s.x1 + dx;
+    int32_t ty1 = s.y1 + dy;
+    int32_t x0 = (tx0 > clip->x0) ? tx0 : clip->x0;
+    int32_t y0 = (ty0 > clip->y0) ? ty0 : clip->y0;
+    int32_t x1 = (tx1 < clip->x1) ? tx1 : clip->x1;
+    int32_t y1 = (ty1 < clip->y1) ? ty1 : clip->y1;
+
+    if (x0 <= x1 && y0 <= y1) {
+        int32_t b0 = x0 >> 3;
+        int32_t b1 = x1 >> 3;
+        uint8_t m0 = 0xFF >> (x0 & 7);
+        uint8_t m1 = (uint8_t)(0xFF << (7 - (x1 & 7)));
+        if (b0 == b1) {
+            m0 &= m1;
+        }
+        uint8_t tmp[EPAPER_ROW_BYTES];
+
+        // 往下移時由下往上搬，避免覆蓋尚未搬移的來源行
+        int32_t step = (dy > 0) ? -1 : 1;
+        int32_t first = (dy > 0) ? y1 : y0;
+        int32_t last = (dy > 0) ? y0 : y1;
+
+        for (int32_t row = first; ; row += step) {
+            uint8_t *dst = epaper->framebuffer + (uint32_t)row * EPAPER_ROW_BYTES;
+            const uint8_t *src = epaper->framebuffer + (uint32_t)(row - dy) * EPAPER_ROW_BYTES;
+
+            if ((dx & 7) == 0) {
+                // byte 對齊：兩端先讀出 (memmove 可能覆蓋它們的來源)，中間直接 memmove
+                int32_t k = dx >> 3;
+                uint8_t first_bits = src[b0 - k];
+                uint8_t last_bits = src[b1 - k];
+                if (b1 - b0 > 1) {
+                    memmove(dst + b0 + 1, src + b0 + 1 - k, b1 - b0 - 1);
+                }
+                dst[b0] = (dst[b0] & ~m0) | (first_bits & m0);
+                if (b1 != b0) {
+                    dst[b1] = (dst[b1] & ~m1) | (last_bits & m1);
+                }
+            } else {
+                // 位移合併到暫存行再寫回 (暫存行讓同一行內的重疊不必考慮方向)
+                shift_row(src, dx, b0, b1, tmp);
+                dst[b0] = (dst[b0] & ~m0) | (tmp[b0] & m0);
+                if (b1 != b0) {
+                    if (b1 - b0 > 1) {
+                        memcpy(dst + b0 + 1, tmp + b0 + 1, b1 - b0 - 1);
+                    }
+                    dst[b1] = (dst[b1] & ~m1) | (tmp[b1] & m1);
+                }
+            }
+
+            if (row == last) {
+                break;
+            }
+        }
+    }
+
+    // 露出的部分 S \ T
+    for (int32_t row = s.y0; row <= s.y1; row++) {
+        if (row < ty0 || row > ty1) {
+            fill_span(epaper, s.x0, s.x1, row, fill);
+            continue;
+        }
+        if (s.x0 < tx0) {
+            fill_span(epaper, s.x0, (tx0 - 1 < s.x1) ? tx0 - 1 : s.x1, row, fill);
+        }
+        if (s.x1 > tx1) {
+            fill_span(epaper, (tx1 + 1 > s.x0) ? tx1 + 1 : s.x0, s.x1, row, fill);
+        }
+    }
+}
+
+// ============================================
+// 顯示更新函數
+// ============================================
+
+static void epaper_refresh(epaper_t *epaper, epaper_lut_profile_t profile);
+
+/**
+ * 設定 RAM 位址計數器到區域起點 (x 需為 8 的倍數，Y 反向)
+ */
+static void epaper_set_ram_pointer(epaper_t *epaper, uint16_t x, uint16_t y)
+{
+    uint16_t y_start = EPAPER_HEIGHT - y - 1;  // Y decrement: 從區域第一行開始
+    
+    // Set X counter
+    epaper_send_command(epaper, 0x4E);
+    epaper_send_data(epaper, x % 256);
+    epaper_send_data(epaper, x / 256);
+    
+    // Set Y counter (reversed)
+    epaper_send_command(epaper, 0x4F);
+    epaper_send_data(epaper, y_start % 256);
+    epaper_send_data(epaper, y_start / 256);
+}
+
+/**
+ * 設定 RAM 視窗與位址計數器 (x, w 需為 8 的倍數且已裁切至螢幕)
+ */
+static void epaper_set_ram_area(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    // Y reversed for this display
+    uint16_t y_reversed = EPAPER_HEIGHT - y - h;
+    
+    // Data entry mode: X increment, Y decrement (reversed)
+    epaper_send_command(epaper, 0x11);
+    epaper_send_data(epaper, 0x01);
+    
+    // Set X range
+    epaper_send_command(epaper, 0x44);
+    epaper_send_data(epaper, x % 256);
+    epaper_send_data(epaper, x / 256);
+    epaper_send_data(epaper, (x + w - 1) % 256);
+    epaper_send_data(epaper, (x + w - 1) / 256);
+    
+    // Set Y range (reversed)
+    epaper_send_command(epaper, 0x45);
+    epaper_send_data(epaper, (y_reversed + h - 1) % 256);
+    epaper_send_data(epaper, (y_reversed + h - 1) / 256);
+    epaper_send_data(epaper, y_reversed % 256);
+    epaper_send_data(epaper, y_reversed / 256);
+    
+    epaper_set_ram_pointer(epaper, x, y);
+}
+
+/**
+ * 清除螢幕
+ */
+void epaper_clear_screen(epaper_t *epaper, uint8_t color)
+{
+    memset(epaper->framebuffer, color, EPAPER_BUFFER_SIZE);
+}
+
+/**
+ * 將 framebuffer 中的區域寫入指定的控制器 RAM (0x24 current / 0x26 previous)
+ * x, w 需為 8 的倍數；RAM 視窗需已由 epaper_set_ram_area 設定
+ */
+static void epaper_write_ram(epaper_t *epaper, uint8_t ram_cmd, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    epaper_set_ram_pointer(epaper, x, y);
+    epaper_send_command(epaper, ram_cmd);
+    
+    if (x == 0 && w == EPAPER_WIDTH) {
+        // 整行連續，一次送出
+        epaper_send_data_bulk(epaper, &epaper->framebuffer[y * EPAPER_ROW_BYTES],
+                              (uint32_t)h * EPAPER_ROW_BYTES);
+        return;
+    }
+    
+    for (uint16_t j = 0; j < h; j++) {
+        uint16_t row = y + j;
+        uint16_t start_byte = (row * EPAPER_WIDTH + x) / 8;
+        uint16_t byte_count = w / 8;
+        epaper_send_data_bulk(epaper, &epaper->framebuffer[start_byte], byte_count);
+    }
+}
+
+/**
+ * 將 current RAM (0x24) 讀回 framebuffer (暖啟動用)
+ * 每行前面有一個 dummy byte，逐行設定位址計數器後讀取
+ *
+ * @return 讀回的畫面雜湊與 frame_hash 相符時回傳 true
+ */
+static bool epaper_read_frame(epaper_t *epaper)
+{
+    if (epaper->frame_hash == 0) {
+        return false;  // 睡眠前面板內容就已經未知
+    }
+    
+    uint8_t row[EPAPER_ROW_BYTES + 1] __attribute__((aligned(4)));
+    
+    epaper_set_ram_area(epaper, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+    epaper_send_command(epaper, 0x41);  // Read RAM Option
+    epaper_send_data(epaper, 0x00);     // 0x24 (BW RAM)
+    
+    for (uint16_t y = 0; y < EPAPER_HEIGHT; y++) {
+        epaper_set_ram_pointer(epaper, 0, y);
+        epaper_send_command(epaper, 0x27);  // Read RAM
+        if (epaper_read_data(epaper, row, sizeof(row)) != ESP_OK) {
+            return false;
+        }
+        memcpy(&epaper->framebuffer[y * EPAPER_ROW_BYTES], &row[1], EPAPER_ROW_BYTES);
+    }
+    
+    return epaper_hash_update(EPAPER_HASH_SEED, epaper->framebuffer, EPAPER_BUFFER_SIZE) == epaper->frame_hash;
+}
+
+/**
+ * 全螢幕更新 (參考 GxEPD2)
+ * 
+ * 全刷時 RED RAM 被 bypass (0x21 = 0x40)，刷新前只需寫入 current (0x24)。
+ * 刷新後再把同一畫面寫入 previous (0x26)，讓之後的部分更新可以做真正的差分。
+ */
+void epaper_display_full(epaper_t *epaper)
+{
+    ESP_LOGI(TAG, "Starting full display update...");
+    
+    // 部分更新會縮小 RAM 視窗，全刷前恢復為全螢幕
+    epaper_set_ram_area(epaper, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+    
+    // Write new frame to "current" buffer (0x24)
+    epaper_write_ram(epaper, 0x24, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+    
+    epaper_refresh(epaper, epaper->full_profile);
+    
+    // Sync "previous" buffer (0x26) with what is now displayed
+    epaper_write_ram(epaper, 0x26, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+    epaper->prev_ram_valid = true;
+    epaper->framebuffer_synced = true;
+    
+    epaper->frame_hash = epaper_hash_update(EPAPER_HASH_SEED, epaper->framebuffer, EPAPER_BUFFER_SIZE);
+    ESP_LOGI(TAG, "Full display update completed");
+}
+
+/**
+ * 將整個面板刷成單一顏色 (不修改 framebuffer)
+ * 用於清除殘影：之後再呼叫 epaper_display_full 顯示 framebuffer 內容
+ */
+void epaper_clear_panel(epaper_t *epaper, uint8_t color)
+{
+    ESP_LOGI(TAG, "Clearing panel to 0x%02X...", color);
+    
+    uint8_t row[EPAPER_WIDTH / 8];
+    memset(row, color, sizeof(row));
+    
+    epaper_set_ram_area(epaper, 0, 0, EPAPER_WIDTH, EPAPER_HEIGHT);
+    
+    epaper_send_command(epaper, 0x26);
+    for (uint16_t j = 0; j < EPAPER_HEIGHT; j++) {
+        epaper_send_data_bulk(epaper, row, sizeof(row));
+    }
+    
+    epaper_set_ram_pointer(epaper, 0, 0);
+    epaper_send_command(epaper, 0x24);
+    for (uint16_t j = 0; j < EPAPER_HEIGHT; j++) {
+        epaper_send_data_bulk(epaper, row, sizeof(row));
+    }
+    
+    epaper_refresh(epaper, epaper->full_profile);
+    epaper->prev_ram_valid = true;  // 兩個 RAM 都是刷新後的顏色
+    epaper->frame_hash = 0;  // 面板內容與 framebuffer 不同
+    epaper->framebuffer_synced = false;
+    ESP_LOGI(TAG, "Panel cleared");
+}
+
+/**
+ * 選擇刷新使用的波形 profile
+ * 依 profile 類型設定為之後的全刷或部分更新所使用
+ */
+esp_err_t epaper_set_refresh_profile(epaper_t *epaper, epaper_lut_profile_t profile)
+{
+    const epaper_lut_def_t *def = epaper_lut_get(profile);
+    if (def == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!epaper_lut_available(profile)) {
+        ESP_LOGW(TAG, "Profile %s needs a custom waveform", def->name);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    
+    if (def->partial) {
+        epaper->partial_profile = profile;
+    } else {
+        epaper->full_profile = profile;
+    }
+    return ESP_OK;
+}
+
+/**
+ * 上傳自訂波形表與電壓設定
+ */
+static void epaper_load_lut(epaper_t *epaper, const epaper_lut_table_t *table)
+{
+    if (epaper->lut_loaded == table) {
+        return;  // 控制器中已是同一份波形
+    }
+    
+    epaper_send_command(epaper, 0x32);  // Write LUT register
+    epaper_send_data_bulk(epaper, table->lut, table->lut_len);
+    
+    if (table->gate_voltage != 0) {
+        epaper_send_command(epaper, 0x03);  // Gate driving voltage
+        epaper_send_data(epaper, table->gate_voltage);
+    }
+    if (table->source_voltage[0] != 0 || table->source_voltage[1] != 0 || table->source_voltage[2] != 0) {
+        epaper_send_command(epaper, 0x04);  // Source driving voltage
+        epaper_send_data_bulk(epaper, table->source_voltage, 3);
+    }
+    if (table->vcom != 0) {
+        epaper_send_command(epaper, 0x2C);  // VCOM
+        epaper_send_data(epaper, table->vcom);
+    }
+    
+    epaper->lut_loaded = table;
+}
+
+/**
+ * 以指定 profile 啟動刷新並等待完成
+ */
+static void epaper_refresh(epaper_t *epaper, epaper_lut_profile_t profile)
+{
+    const epaper_lut_def_t *def = epaper_lut_get(profile);
+    uint8_t sequence;
+    
+    if (def->custom != NULL) {
+        // 自訂波形：上傳 LUT，刷新時不再從 OTP 載入
+        epaper_load_lut(epaper, def->custom);
+        sequence = def->partial ? EPAPER_SEQ_PARTIAL_CUSTOM : EPAPER_SEQ_FULL_CUSTOM;
+    } else {
+        if (def->fast_temperature) {
+            // 快速模式：依面板溫度選擇仍能完整驅動的最短波形
+            uint8_t fast = epaper_fast_temperature(epaper);
+            epaper_send_command(epaper, 0x1A);  // Write to temperature register
+            epaper_send_data(epaper, fast);
+            ESP_LOGI(TAG, "Fast mode temperature: 0x%02X (panel %d C)", fast, epaper->temperature);
+        }
+        sequence = def->otp_sequence;
+        epaper->lut_loaded = NULL;  // OTP 載入會覆蓋 LUT 暫存器
+    }
+    
+    // 反相預刷：BW RAM 以反相內容驅動一次，所有像素翻轉後再刷回目標
+    int64_t busy_start_us = esp_timer_get_time();
+    for (int pass = def->invert_prepass ? 0 : 1; pass < 2; pass++) {
+        uint8_t update_ctrl = def->partial ? 0x00 : 0x40;  // RED normal / Bypass RED as 0
+        if (pass == 0) {
+            update_ctrl |= 0x08;                            // Inverse BW RAM content
+        }
+        
+        // Power on and update
+        epaper_send_command(epaper, 0x21);  // Display Update Control
+        epaper_send_data(epaper, update_ctrl);
+        epaper_send_data(epaper, 0x00);     // Single chip application
+        
+        epaper_send_command(epaper, 0x22);  // Display Update Sequence
+        epaper_send_data(epaper, sequence);
+        
+        epaper_send_command(epaper, 0x20);  // Master Activation
+        vTaskDelay(pdMS_TO_TICKS(100));
+        epaper_wait_busy();
+    }
+    
+    epaper_record_refresh(epaper, def->partial ? EPAPER_REFRESH_PARTIAL : EPAPER_REFRESH_FULL,
+                          profile, busy_start_us);
+}
+
+/**
+ * 部分更新 (參考 GxEPD2)
+ */
+void epaper_display_partial(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    ESP_LOGI(TAG, "Starting partial update: x=%d, y=%d, w=%d, h=%d", x, y, w, h);
+    
+    // Make x, w multiple of 8 (byte boundary)
+    w += x % 8;
+    x -= x % 8;
+    w = (w + 7) & ~7;
+    
+    // Limit to screen bounds
+    if (x >= EPAPER_WIDTH || y >= EPAPER_HEIGHT) return;
+    if (x + w > EPAPER_WIDTH) w = EPAPER_WIDTH - x;
+    if (y + h > EPAPER_HEIGHT) h = EPAPER_HEIGHT - y;
+    
+    // Set partial RAM area
+    epaper_set_ram_area(epaper, x, y, w, h);
+    
+    // 差分更新：previous (0x26) 已經是目前顯示的內容，刷新前只需寫入新畫面到 current (0x24)，
+    // 控制器只驅動有變化的像素。開機後 0x26 內容未知時，先寫入新畫面避免殘留舊資料。
+    if (!epaper->prev_ram_valid) {
+        epaper_write_ram(epaper, 0x26, x, y, w, h);
+    }
+    epaper_write_ram(epaper, 0x24, x, y, w, h);
+    
+    epaper_refresh(epaper, epaper->partial_profile);
+    
+    // Sync "previous" buffer (0x26) for the next differential update
+    epaper_write_ram(epaper, 0x26, x, y, w, h);
+    
+    // framebuffer 的其他區域與面板不同時 (例如暖啟動後)，雜湊無法代表面板畫面
+    epaper->frame_hash = epaper->framebuffer_synced ?
+                         epaper_hash_update(EPAPER_HASH_SEED, epaper->framebuffer, EPAPER_BUFFER_SIZE) : 0;
+    
+    ESP_LOGI(TAG, "Partial update completed");
+}
+
+// ============================================
+// 文字繪製函數
+// ============================================
+
+/**
+ * 繪製 8x16 ASCII 字符
+ */
+void epaper_draw_char_8x16(epaper_t *epaper, uint16_t x, uint16_t y, char c, uint8_t color)
+{
+    // 使用新的字體 API
+    epaper_draw_bitmap(epaper, x, y, get_ascii_font(c), 8, 16, color);
+}
+
+/**
+ * 繪製 16x16 中文字符
+ */
+void epaper_draw_chinese_16x16(epaper_t *epaper, uint16_t x, uint16_t y, const char *utf8_char, uint8_t color)
+{
+    const uint8_t *font_data = get_chinese_font(utf8_char);
     if (font_data == NULL) {
-        ESP_LOGI(TAG, "Chinese char not found");
+        ESP_LOGD(TAG, "Chinese char not found");
         return; // 字符不存在
     }
     
-    ESP_LOGI(TAG, "Drawing Chinese char at (%d,%d)", x, y);
+    // 16x16 點陣每行 2 bytes，高位在左，與 bitmap 格式相同
+    epaper_draw_bitmap(epaper, x, y, font_data, 16, 16, color);
+}
+
+/**
+ * 區域完全在裁切矩形之外 (不需要查字形)
+ */
+static bool clipped_out(const epaper_t *epaper, uint16_t x, uint16_t y, uint32_t w, uint32_t h)
+{
+    epaper_rect_t r;
+    return !epaper_clip_rect(epaper, x, y, (int32_t)w, (int32_t)h, &r);
+}
+
+/**
+ * 字元的前進寬度：ASCII 與半形字元 8 px，全形字元 16 px (缺字時的替代字形寬度相同)
+ */
+uint16_t epaper_glyph_advance(uint32_t codepoint)
+{
+    if (codepoint < 0x80) {
+        return 8;
+    }
+    return font_is_wide(codepoint) ? 16 : 8;
+}
+
+/**
+ * 經由字形快取取得字形，未命中時依序查詢內建字型與 flash 字型分區
+ * 
+ * @return 字形資料 (8x16 為 16 bytes，16x16 為 32 bytes)，字型中沒有時為 NULL
+ */
+static const uint8_t *epaper_find_glyph(epaper_t *epaper, uint32_t codepoint, bool wide)
+{
+    uint8_t font_id = wide ? GLYPH_FONT_CJK_16X16 : GLYPH_FONT_ASCII_8X16;
+    
+    const uint8_t *glyph = glyph_cache_lookup(font_id, codepoint);
+    if (glyph != NULL) {
+        epaper->stats.glyph_hits++;
+        return glyph;
+    }
+    epaper->stats.glyph_misses++;
     
-    for (int row = 0; row < 16; row++) {
-        uint8_t byte1 = font_data[row * 2];
-        uint8_t byte2 = font_data[row * 2 + 1];
-        
-        if (row < 3) {  // 只輸出前3行作為範例
-            ESP_LOGI(TAG, "  Row %d: 0x%02X 0x%02X", row, byte1, byte2);
+    if (!wide) {
+        if (codepoint >= 0x80) {
+            font_report_missing(codepoint);
+            return NULL;
         }
-        
-        // 處理高字節 (前 8 位)
-        for (int col = 0; col < 8; col++) {
-            if (byte1 & (0x80 >> col)) {
-                epaper_set_pixel(epaper, x + col, y + row, color);
+        glyph = get_ascii_font((char)codepoint);
+    } else {
+        glyph = get_chinese_font_cp(codepoint);
+        font_store_glyph_t stored;
+        if (glyph == NULL && font_store_find(16, codepoint, &stored) && stored.width == 16) {
+            // 字型分區的字形 (可能已壓縮) 直接解碼到快取槽
+            uint8_t *slot = glyph_cache_alloc(font_id, codepoint);
+            if (font_store_decode(&stored, slot, GLYPH_CACHE_GLYPH_SIZE) != ESP_OK) {
+                ESP_LOGE(TAG, "Corrupt glyph U+%04lX in font partition", codepoint);
+                memcpy(slot, font_replacement_16x16, sizeof(font_replacement_16x16));
             }
+            return slot;
+        }
+    }
+    
+    if (glyph == NULL) {
+        font_report_missing(codepoint);
+        return NULL;
+    }
+    return glyph_cache_insert(font_id, codepoint, glyph, wide ? 32 : 16);
+}
+
+/**
+ * 繪製單一碼位，字型中沒有的字元畫替代字形
+ * 
+ * @return 前進寬度 (px)
+ */
+uint16_t epaper_draw_glyph(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t color)
+{
+    uint16_t advance = epaper_glyph_advance(codepoint);
+    if (clipped_out(epaper, x, y, advance, 16)) {
+        return advance;
+    }
+    
+    bool wide = (advance == 16);
+    const uint8_t *glyph = epaper_find_glyph(epaper, codepoint, wide);
+    if (glyph != NULL) {
+        epaper_draw_bitmap(epaper, x, y, glyph, advance, 16, color);
+    } else if (wide) {
+        epaper_draw_bitmap(epaper, x, y, font_replacement_16x16, 16, 16, color);
+    } else {
+        epaper_draw_bitmap(epaper, x, y, font_replacement_8x16, 8, 16, color);
+    }
+    return advance;
+}
+
+/**
+ * 放大繪製單一碼位 (每個像素畫成 scale x scale 的方塊)
+ * 
+ * @return 前進寬度 (px，已放大)
+ */
+uint16_t epaper_draw_glyph_scaled(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t scale, uint8_t color)
+{
+    if (scale <= 1) {
+        return epaper_draw_glyph(epaper, x, y, codepoint, color);
+    }
+    
+    uint16_t advance = epaper_glyph_advance(codepoint);
+    if (clipped_out(epaper, x, y, (uint32_t)advance * scale, 16 * scale)) {
+        return advance * scale;
+    }
+    
+    bool wide = (advance == 16);
+    const uint8_t *glyph = epaper_find_glyph(epaper, codepoint, wide);
+    if (glyph == NULL) {
+        glyph = wide ? font_replacement_16x16 : font_replacement_8x16;
+    }
+    
+    epaper_draw_bitmap_scaled(epaper, x, y, glyph, advance, 16, scale, color);
+    return advance * scale;
+}
+
+/**
+ * 繪製字型分區中指定高度的字形 (標題用的 24 / 32 px 字型)
+ * 壓縮字形逐行解碼後直接畫到 framebuffer，不需要整個字形的暫存區
+ * 
+ * @return 前進寬度 (px)，字型中沒有此字元時回傳 0
+ */
+uint16_t epaper_draw_font_glyph(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t size, uint8_t color)
+{
+    font_store_glyph_t glyph;
+    if (!font_store_find(size, codepoint, &glyph)) {
+        return 0;
+    }
+    if (clipped_out(epaper, x, y, glyph.width, glyph.height)) {
+        return glyph.width;
+    }
+    
+    font_store_reader_t reader;
+    uint8_t row[FONT_STORE_MAX_SIZE / 8];
+    font_store_reader_init(&reader, &glyph);
+    for (uint16_t r = 0; r < glyph.height; r++) {
+        if (font_store_read_row(&reader, row) != ESP_OK) {
+            ESP_LOGE(TAG, "Corrupt glyph U+%04lX in font partition", codepoint);
+            break;
+        }
+        epaper_draw_bitmap(epaper, x, y + r, row, glyph.width, 1, color);
+    }
+    return glyph.width;
+}
+
+/**
+ * 取得 ASCII 字形的墨跡範圍 (比例字型使用)
+ * 
+ * @param left  最左邊有像素的欄
+ * @param width 墨跡寬度
+ * @return 非 ASCII 或空白字形時回傳 false
+ */
+bool epaper_glyph_ink(uint32_t codepoint, uint8_t *left, uint8_t *width)
+{
+    if (codepoint < 0x20 || codepoint > 0x7E) {
+        return false;
+    }
+    
+    const uint8_t *glyph = get_ascii_font((char)codepoint);
+    uint8_t mask = 0;
+    for (int row = 0; row < 16; row++) {
+        mask |= glyph[row];
+    }
+    if (mask == 0) {
+        return false;
+    }
+    
+    uint8_t l = 0;
+    while (!(mask & (0x80 >> l))) l++;
+    uint8_t r = 7;
+    while (!(mask & (0x80 >> r))) r--;
+    
+    *left = l;
+    *width = r - l + 1;
+    return true;
+}
+
+/**
+ * 將字串渲染成快取中的點陣 (字寬都是 8 的倍數，逐 byte 複製)
+ * 只在 text_cache_admit 同意後呼叫
+ * 
+ * @return 快取中的點陣，字串不適合快取時為 NULL
+ */
+static const uint8_t *epaper_render_string(epaper_t *epaper, const char *str, uint16_t *width)
+{
+    uint16_t w = epaper_measure_string(str);
+    if (w == 0 || w > EPAPER_WIDTH) {
+        return NULL;
+    }
+    
+    uint8_t *bitmap = text_cache_alloc(TEXT_CACHE_FONT_16, str, w, 16);
+    if (bitmap == NULL) {
+        return NULL;
+    }
+    
+    uint16_t stride = w / 8;
+    uint16_t col = 0;
+    const char *p = str;
+    while (*p != '\0') {
+        uint32_t codepoint = utf8_next(&p);
+        uint16_t advance = epaper_glyph_advance(codepoint);
+        bool wide = (advance == 16);
+        const uint8_t *glyph = epaper_find_glyph(epaper, codepoint, wide);
+        if (glyph == NULL) {
+            glyph = wide ? font_replacement_16x16 : font_replacement_8x16;
         }
         
-        // 處理低字節 (後 8 位)
-        for (int col = 0; col < 8; col++) {
-            if (byte2 & (0x80 >> col)) {
-                epaper_set_pixel(epaper, x + 8 + col, y + row, color);
-            }
+        uint16_t glyph_bytes = advance / 8;
+        for (int row = 0; row < 16; row++) {
+            memcpy(bitmap + row * stride + col, glyph + row * glyph_bytes, glyph_bytes);
         }
+        col += glyph_bytes;
     }
+    
+    *width = w;
+    return bitmap;
 }
 
 /**
- * 繪製混合字符串 (支持 ASCII 和中文)
+ * 繪製 UTF-8 字串
+ * 不合法的 UTF-8 序列以替代字形顯示，超出裁切矩形的部分不繪製
  */
 void epaper_draw_string(epaper_t *epaper, uint16_t x, uint16_t y, const char *str, uint8_t color)
 {
-    uint16_t cursor_x = x;
+    // 使用文字點陣快取，一次 blit 完成 (由 blit 裁切)；第二次使用才渲染進快取
+    uint16_t width = 0;
+    uint16_t height = 0;
+    const uint8_t *bitmap = text_cache_lookup(TEXT_CACHE_FONT_16, str, &width, &height);
+    if (bitmap == NULL && text_cache_admit(TEXT_CACHE_FONT_16, str)) {
+        bitmap = epaper_render_string(epaper, str, &width);
+        height = 16;
+    }
+    if (bitmap != NULL) {
+        epaper_draw_bitmap(epaper, x, y, bitmap, width, height, color);
+        return;
+    }
+    
+    // 不放入快取 (第一次使用、過長或記憶體不足)：逐字繪製到裁切矩形右緣為止
+    uint32_t cursor_x = x;
+    const char *p = str;
+    
+    while (*p != '\0' && screen_x(epaper, cursor_x) <= epaper->view.clip.x1) {
+        uint32_t codepoint = utf8_next(&p);
+        cursor_x += epaper_draw_glyph(epaper, (uint16_t)cursor_x, y, codepoint, color);
+    }
+}
+
+/**
+ * 放大繪製 UTF-8 字串 (大字體時鐘、標題)
+ * 使用與 epaper_draw_string 相同的 1x 文字點陣快取，繪製時查表放大
+ */
+void epaper_draw_string_scaled(epaper_t *epaper, uint16_t x, uint16_t y, const char *str, uint8_t scale, uint8_t color)
+{
+    if (scale <= 1) {
+        epaper_draw_string(epaper, x, y, str, color);
+        return;
+    }
+    
+    uint16_t width = 0;
+    uint16_t height = 0;
+    const uint8_t *bitmap = text_cache_lookup(TEXT_CACHE_FONT_16, str, &width, &height);
+    if (bitmap == NULL && text_cache_admit(TEXT_CACHE_FONT_16, str)) {
+        bitmap = epaper_render_string(epaper, str, &width);
+        height = 16;
+    }
+    if (bitmap != NULL) {
+        epaper_draw_bitmap_scaled(epaper, x, y, bitmap, width, height, scale, color);
+        return;
+    }
+    
+    // 不放入快取：逐字繪製到裁切矩形右緣為止
+    uint32_t cursor_x = x;
+    const char *p = str;
+    
+    while (*p != '\0' && screen_x(epaper, cursor_x) <= epaper->view.clip.x1) {
+        uint32_t codepoint = utf8_next(&p);
+        cursor_x += epaper_draw_glyph_scaled(epaper, (uint16_t)cursor_x, y, codepoint, scale, color);
+    }
+}
+
+/**
+ * 計算字串寬度 (px)，與 epaper_draw_string 使用相同的解碼與字寬規則
+ */
+uint16_t epaper_measure_string(const char *str)
+{
+    uint32_t width = 0;
     const char *p = str;
     
     while (*p != '\0') {
-        if ((uint8_t)*p < 0x80) {
-            // ASCII 字符
-            epaper_draw_char_8x16(epaper, cursor_x, y, *p, color);
-            cursor_x += 8;
-            p++;
-        } else {
-            // UTF-8 中文字符 (3 字節)
-            epaper_draw_chinese_16x16(epaper, cursor_x, y, p, color);
-            cursor_x += 16;
-            p += 3; // 跳過 3 個字節
+        width += epaper_glyph_advance(utf8_next(&p));
+        if (width >= UINT16_MAX) {
+            return UINT16_MAX;
         }
     }
+    
+    return (uint16_t)width;
 }
-
@@ -18,16 +18,18 @@
 #include <stdbool.h>
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
+#include "epaper_lut.h"
 
 // Display specifications
 #define EPAPER_WIDTH        800
 #define EPAPER_HEIGHT       480
 #define EPAPER_BUFFER_SIZE  (EPAPER_WIDTH * EPAPER_HEIGHT / 8)  // 48000 bytes
+#define EPAPER_ROW_BYTES    (EPAPER_WIDTH / 8)                  // 100 bytes per row
 
 // GPIO Pin definitions
 #define PIN_SCLK            2
 #define PIN_MOSI            3
-#define PIN_MISO            5   // Not used but required for SPI configuration
+// MISO is not wired: the controller is read back over MOSI (3-wire half-duplex)
 #define PIN_CS              10
 #define PIN_DC              4
 #define PIN_RST             5
@@ -37,13 +39,16 @@
 #define SPI_HOST_ID         SPI2_HOST
 #define SPI_CLOCK_SPEED     (4 * 1000 * 1000)  // 4 MHz
 
+// Panel temperature is re-read when the cached value is older than this
+#define EPAPER_TEMP_INTERVAL_MS     (10 * 60 * 1000)
+
 // E-Paper Commands (based on GDEQ0426T82 datasheet)
 #define CMD_PANEL_SETTING           0x00
 #define CMD_POWER_SETTING           0x01
 #define CMD_POWER_OFF               0x02
 #define CMD_POWER_ON                0x04
 #define CMD_BOOSTER_SOFT_START      0x06
-#define CMD_DEEP_SLEEP              0x07
+#define CMD_DEEP_SLEEP              0x07    // UC81xx; SSD1677 uses SSD_DEEP_SLEEP
 #define CMD_DATA_START_TRANSMISSION 0x10
 #define CMD_DATA_STOP                0x11
 #define CMD_DISPLAY_REFRESH         0x12
@@ -55,15 +60,91 @@
 #define CMD_RESOLUTION_SETTING      0x61
 #define CMD_GET_STATUS              0x71
 
+// SSD1677 deep sleep (mode 1 keeps RAM contents, exit with hardware reset)
+#define SSD_DEEP_SLEEP              0x10
+#define SSD_DEEP_SLEEP_MODE1        0x01
+
 // Color definitions
 #define COLOR_WHITE         0xFF
 #define COLOR_BLACK         0x00
 
+// Polygon fill
+#define EPAPER_POLY_MAX_POINTS  128
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+} epaper_point_t;
+
+typedef enum {
+    EPAPER_FILL_EVEN_ODD = 0,
+    EPAPER_FILL_NONZERO,
+} epaper_fill_rule_t;
+
+// Viewport / clip stack depth (epaper_push_viewport / epaper_push_clip)
+#define EPAPER_VIEW_DEPTH       8
+
+// Rectangle in panel coordinates (inclusive: x0..x1, y0..y1; empty when x0 > x1 or y0 > y1)
+typedef struct {
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} epaper_rect_t;
+
+// Drawing viewport: drawing coordinates are relative to (ox, oy) and clipped to clip
+typedef struct {
+    int16_t ox;
+    int16_t oy;
+    epaper_rect_t clip;     // Always inside the panel
+} epaper_viewport_t;
+
+// Frame hash (FNV-1a 32-bit)
+#define EPAPER_HASH_SEED    0x811C9DC5u
+
+// Refresh modes (reported in stats)
+typedef enum {
+    EPAPER_REFRESH_NONE = 0,
+    EPAPER_REFRESH_FULL,
+    EPAPER_REFRESH_PARTIAL,
+} epaper_refresh_mode_t;
+
+// Timing statistics, accumulated until epaper_stats_reset()
+typedef struct {
+    uint32_t spi_us;        // Time spent in SPI transactions
+    uint32_t spi_bytes;     // Bytes sent over SPI
+    uint32_t busy_us;       // Time from Master Activation until BUSY released
+    uint8_t refresh_count;  // Number of refresh cycles
+    epaper_refresh_mode_t last_refresh;
+    epaper_lut_profile_t last_profile;
+    int8_t panel_temperature;   // Last panel temperature reading (°C)
+    uint8_t fast_temperature;   // Temperature register value used for fast full refresh
+    uint32_t glyph_hits;        // Glyphs served from the glyph cache
+    uint32_t glyph_misses;      // Glyphs fetched from font storage
+} epaper_stats_t;
+
 // E-Paper driver structure
 typedef struct {
     spi_device_handle_t spi;
     uint8_t *framebuffer;
     bool initialized;
+    uint32_t frame_hash;    // Hash of the framebuffer at the last display update (0 = unknown)
+    bool prev_ram_valid;    // Controller "previous" RAM (0x26) holds the displayed image
+    epaper_stats_t stats;
+    epaper_lut_profile_t full_profile;      // Waveform profile for full refreshes
+    epaper_lut_profile_t partial_profile;   // Waveform profile for partial refreshes
+    const epaper_lut_table_t *lut_loaded;   // Custom LUT currently in the controller (NULL = OTP)
+    epaper_lut_stats_t profile_stats[EPAPER_LUT_PROFILE_COUNT];
+    int8_t temperature;             // Cached panel temperature (°C)
+    bool temperature_valid;
+    int64_t temperature_time_us;    // When the temperature was read
+    bool warm_start;                // Woke from epaper_sleep(): panel RAM still holds the last frame
+    bool framebuffer_synced;        // Framebuffer matches the whole panel image
+    uint32_t wake_to_spi_us;        // Time from boot to the first SPI transaction
+    uint32_t init_us;               // Duration of epaper_init
+    epaper_viewport_t view;         // Active viewport (origin + clip) used by all drawing functions
+    epaper_viewport_t view_stack[EPAPER_VIEW_DEPTH];
+    uint8_t view_depth;
 } epaper_t;
 
 // Initialization and control functions
@@ -71,27 +152,65 @@ esp_err_t epaper_init(epaper_t *epaper);
 esp_err_t epaper_deinit(epaper_t *epaper);
 void epaper_reset(void);
 void epaper_sleep(epaper_t *epaper);
-void epaper_wait_busy(void);
+uint32_t epaper_wait_busy(void);
+void epaper_stats_reset(epaper_t *epaper);
+esp_err_t epaper_set_refresh_profile(epaper_t *epaper, epaper_lut_profile_t profile);
 
 // Low-level communication functions
 void epaper_send_command(epaper_t *epaper, uint8_t cmd);
 void epaper_send_data(epaper_t *epaper, uint8_t data);
 void epaper_send_data_bulk(epaper_t *epaper, const uint8_t *data, size_t len);
+esp_err_t epaper_read_data(epaper_t *epaper, uint8_t *data, size_t len);
+
+// Temperature functions
+esp_err_t epaper_read_temperature(epaper_t *epaper, int8_t *temperature);
 
 // Display update functions
 void epaper_clear_screen(epaper_t *epaper, uint8_t color);
 void epaper_display_full(epaper_t *epaper);
+void epaper_clear_panel(epaper_t *epaper, uint8_t color);
 void epaper_display_partial(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
-// Framebuffer functions
+// Frame hash functions
+uint32_t epaper_hash_update(uint32_t hash, const uint8_t *data, size_t len);
+
+// Viewport / clip functions
+esp_err_t epaper_push_viewport(epaper_t *epaper, int16_t x, int16_t y, uint16_t w, uint16_t h);
+esp_err_t epaper_push_clip(epaper_t *epaper, int16_t x, int16_t y, uint16_t w, uint16_t h);
+void epaper_pop_viewport(epaper_t *epaper);
+void epaper_reset_viewport(epaper_t *epaper);
+bool epaper_clip_rect(const epaper_t *epaper, int32_t x, int32_t y, int32_t w, int32_t h, epaper_rect_t *out);
+
+// Framebuffer functions (coordinates are relative to the active viewport)
 void epaper_set_pixel(epaper_t *epaper, uint16_t x, uint16_t y, uint8_t color);
 uint8_t epaper_get_pixel(epaper_t *epaper, uint16_t x, uint16_t y);
+void epaper_draw_hline(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint8_t color);
+void epaper_draw_vline(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t h, uint8_t color);
 void epaper_fill_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color);
+void epaper_fill_clip(epaper_t *epaper, uint8_t color);
 void epaper_draw_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color);
+void epaper_draw_line(epaper_t *epaper, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t color);
+void epaper_draw_circle(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r, uint8_t color);
+void epaper_fill_circle(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r, uint8_t color);
+void epaper_draw_arc(epaper_t *epaper, uint16_t cx, uint16_t cy, uint16_t r, int16_t start_deg, int16_t end_deg, uint8_t color);
+void epaper_draw_round_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t r, uint8_t color);
+void epaper_fill_round_rect(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t r, uint8_t color);
+esp_err_t epaper_fill_polygon(epaper_t *epaper, const epaper_point_t *points, uint16_t count, epaper_fill_rule_t rule, uint8_t color);
+void epaper_draw_polygon(epaper_t *epaper, const epaper_point_t *points, uint16_t count, bool closed, uint8_t color);
+void epaper_draw_bitmap(epaper_t *epaper, uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint8_t color);
+void epaper_draw_bitmap_scaled(epaper_t *epaper, uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint8_t scale, uint8_t color);
+void epaper_move_region(epaper_t *epaper, uint16_t x, uint16_t y, uint16_t w, uint16_t h, int16_t dx, int16_t dy, uint8_t fill);
 
 // Text drawing functions
 void epaper_draw_char_8x16(epaper_t *epaper, uint16_t x, uint16_t y, char c, uint8_t color);
 void epaper_draw_chinese_16x16(epaper_t *epaper, uint16_t x, uint16_t y, const char *utf8_char, uint8_t color);
+uint16_t epaper_draw_glyph(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t color);
+uint16_t epaper_draw_glyph_scaled(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t scale, uint8_t color);
+uint16_t epaper_draw_font_glyph(epaper_t *epaper, uint16_t x, uint16_t y, uint32_t codepoint, uint8_t size, uint8_t color);
+uint16_t epaper_glyph_advance(uint32_t codepoint);
+bool epaper_glyph_ink(uint32_t codepoint, uint8_t *left, uint8_t *width);
 void epaper_draw_string(epaper_t *epaper, uint16_t x, uint16_t y, const char *str, uint8_t color);
+void epaper_draw_string_scaled(epaper_t *epaper, uint16_t x, uint16_t y, const char *str, uint8_t scale, uint8_t color);
+uint16_t epaper_measure_string(const char *str);
 
 #endif // EPAPER_DRIVER_H
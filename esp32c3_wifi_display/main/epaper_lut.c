@@ -0,0 +1,105 @@
+/*
+ * SSD1677 Waveform LUT Profiles 實作
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#include <stddef.h>
+#include "esp_log.h"
+#include "epaper_lut.h"
+
+static const char *TAG = "EPaperLUT";
+
+// Profile 表 (custom 欄位由 epaper_lut_register 設定)
+static epaper_lut_def_t lut_profiles[EPAPER_LUT_PROFILE_COUNT] = {
+    [EPAPER_LUT_FAST_FULL] = {
+        .name = "fast-full",
+        .partial = false,
+        .otp_sequence = EPAPER_SEQ_FAST_FULL_OTP,
+        .fast_temperature = true,       // 依面板溫度選擇快速波形
+    },
+    [EPAPER_LUT_FAST_PARTIAL] = {
+        .name = "fast-partial",
+        .partial = true,
+        .otp_sequence = EPAPER_SEQ_PARTIAL_OTP,
+    },
+    [EPAPER_LUT_QUALITY_FULL] = {
+        .name = "quality-full",
+        .partial = false,
+        .otp_sequence = EPAPER_SEQ_FULL_OTP,
+    },
+    [EPAPER_LUT_GHOST_CLEAN] = {
+        .name = "ghost-clean",
+        .partial = false,
+        .otp_sequence = EPAPER_SEQ_FULL_OTP,
+        .invert_prepass = true,         // 先反相刷新一次，再刷回目標畫面
+    },
+    [EPAPER_LUT_GRAYSCALE] = {
+        .name = "grayscale",
+        .partial = false,
+        .otp_sequence = 0,              // 沒有對應的 OTP 波形
+    },
+};
+
+// 溫度區間 → 快速全刷溫度值 (依 min_temp 由高到低排列)
+typedef struct {
+    int8_t min_temp;        // 區間下限 (°C)
+    uint8_t fast_temp;      // 寫入 0x1A 的值 (°C)
+} fast_temp_band_t;
+
+static const fast_temp_band_t fast_temp_bands[] = {
+    { 18, 0x5A },   // 室溫以上：最快波形 (90°C)
+    { 10, 0x50 },   // 偏冷：80°C
+    {  0, 0x3C },   // 寒冷：60°C
+};
+
+const epaper_lut_def_t *epaper_lut_get(epaper_lut_profile_t profile)
+{
+    if (profile >= EPAPER_LUT_PROFILE_COUNT) {
+        return NULL;
+    }
+    return &lut_profiles[profile];
+}
+
+esp_err_t epaper_lut_register(epaper_lut_profile_t profile, const epaper_lut_table_t *table)
+{
+    if (profile >= EPAPER_LUT_PROFILE_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (table != NULL && (table->lut == NULL || table->lut_len == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    lut_profiles[profile].custom = table;
+
+    if (table != NULL) {
+        ESP_LOGI(TAG, "Custom waveform registered for %s (%d bytes)",
+                 lut_profiles[profile].name, table->lut_len);
+    } else {
+        ESP_LOGI(TAG, "%s reverted to OTP waveform", lut_profiles[profile].name);
+    }
+    return ESP_OK;
+}
+
+bool epaper_lut_available(epaper_lut_profile_t profile)
+{
+    const epaper_lut_def_t *def = epaper_lut_get(profile);
+    if (def == NULL) {
+        return false;
+    }
+    return def->custom != NULL || def->otp_sequence != 0;
+}
+
+uint8_t epaper_lut_fast_temperature(int8_t panel_temp)
+{
+    for (size_t i = 0; i < sizeof(fast_temp_bands) / sizeof(fast_temp_bands[0]); i++) {
+        if (panel_temp >= fast_temp_bands[i].min_temp) {
+            uint8_t fast = fast_temp_bands[i].fast_temp;
+            return (panel_temp > (int8_t)fast) ? (uint8_t)panel_temp : fast;
+        }
+    }
+
+    // 冰點以下：不加速，以 2 的補數寫入實際溫度，使用對應的低溫波形
+    return (uint8_t)panel_temp;
+}
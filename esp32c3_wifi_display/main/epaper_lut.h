@@ -0,0 +1,101 @@
+/*
+ * SSD1677 Waveform LUT Profiles
+ *
+ * 每個刷新 profile 決定控制器使用的波形：
+ * - 使用 OTP 內建波形：只設定 Display Update Sequence (0x22) 與溫度暫存器 (0x1A)
+ * - 使用自訂波形表：透過 0x32 上傳 LUT，並設定 gate/source 電壓與 VCOM
+ *
+ * 自訂波形表與面板批次相關，由應用程式透過 epaper_lut_register() 提供；
+ * 未註冊時 fast-partial / quality-full / ghost-clean 使用 OTP 波形，
+ * grayscale 則無法使用 (需要自訂波形)。
+ *
+ * ghost-clean 與 quality-full 使用相同波形，但先以反相的 RAM 內容刷新一次
+ * (每個像素先翻到相反顏色再回到目標)，把殘留的顏料完整推動一次。
+ */
+
+#ifndef EPAPER_LUT_H
+#define EPAPER_LUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// Refresh profiles
+typedef enum {
+    EPAPER_LUT_FAST_FULL = 0,   // 快速全刷 (OTP, 0xD7 + 固定溫度)
+    EPAPER_LUT_FAST_PARTIAL,    // 快速部分更新 (OTP, 0xFC)
+    EPAPER_LUT_QUALITY_FULL,    // 高品質全刷 (OTP, 0xF7，讀取實際溫度)
+    EPAPER_LUT_GHOST_CLEAN,     // 清除殘影 (OTP, 0xF7，反相預刷 + 正常刷新，用於刷白)
+    EPAPER_LUT_GRAYSCALE,       // 灰階 (僅限自訂波形)
+    EPAPER_LUT_PROFILE_COUNT
+} epaper_lut_profile_t;
+
+// Display Update Sequence (0x22) values
+#define EPAPER_SEQ_FULL_OTP         0xF7    // Load temperature + OTP LUT, display mode 1
+#define EPAPER_SEQ_FAST_FULL_OTP    0xD7    // Load OTP LUT with temperature register value, mode 1
+#define EPAPER_SEQ_PARTIAL_OTP      0xFC    // Load temperature + OTP LUT, display mode 2
+#define EPAPER_SEQ_FULL_CUSTOM      0xC7    // Use LUT register, display mode 1
+#define EPAPER_SEQ_PARTIAL_CUSTOM   0xCF    // Use LUT register, display mode 2
+
+// Temperature sensing sequence (load temperature + LUT, no display)
+#define EPAPER_SEQ_LOAD_TEMP        0xB1
+
+// Fast-mode temperature used when the panel temperature cannot be read
+#define EPAPER_FAST_TEMP_DEFAULT    0x5A
+
+// Custom waveform table (uploaded via 0x32)
+typedef struct {
+    const uint8_t *lut;         // Waveform data for command 0x32
+    uint16_t lut_len;
+    uint8_t gate_voltage;       // 0x03 (0 = keep default)
+    uint8_t source_voltage[3];  // 0x04 VSH1, VSH2, VSL (all 0 = keep default)
+    uint8_t vcom;               // 0x2C (0 = keep default)
+} epaper_lut_table_t;
+
+// Profile definition
+typedef struct {
+    const char *name;
+    bool partial;                       // Display mode 2 (partial) refresh
+    uint8_t otp_sequence;               // 0x22 value when using the OTP waveform
+    bool fast_temperature;              // Override 0x1A with epaper_lut_fast_temperature() (OTP only)
+    bool invert_prepass;                // Refresh once with inverted BW RAM before the normal refresh
+    const epaper_lut_table_t *custom;   // Registered custom waveform (NULL = OTP)
+} epaper_lut_def_t;
+
+// Per-profile refresh timing, measured from Master Activation to BUSY released
+typedef struct {
+    uint32_t count;
+    uint32_t last_us;
+    uint32_t total_us;
+} epaper_lut_stats_t;
+
+/**
+ * 取得 profile 定義
+ */
+const epaper_lut_def_t *epaper_lut_get(epaper_lut_profile_t profile);
+
+/**
+ * 為 profile 註冊自訂波形表 (table 需在使用期間保持有效，NULL 表示恢復 OTP 波形)
+ */
+esp_err_t epaper_lut_register(epaper_lut_profile_t profile, const epaper_lut_table_t *table);
+
+/**
+ * profile 是否可以使用
+ */
+bool epaper_lut_available(epaper_lut_profile_t profile);
+
+/**
+ * 依面板實際溫度選擇快速全刷寫入溫度暫存器 (0x1A) 的值
+ *
+ * 寫入較高的溫度會讓 OTP 選用較短的波形；面板越冷，可以提高的幅度越小，
+ * 否則顏料移動不足而畫面偏淡。回傳值不會低於實際溫度。
+ *
+ * 0x1A 的溫度為 2 的補數：冰點以下不加速，直接回傳實際溫度的補數表示
+ * (例如 -5 °C 回傳 0xFB)，控制器會選用對應的低溫波形。
+ *
+ * @param panel_temp 面板溫度 (°C)
+ * @return 溫度暫存器值 (°C，2 的補數)
+ */
+uint8_t epaper_lut_fast_temperature(int8_t panel_temp);
+
+#endif // EPAPER_LUT_H
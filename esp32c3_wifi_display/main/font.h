@@ -1,274 +0,0 @@
-/*
- * 標準 ASCII 和中文字體定義
- * 
- * 字體格式：
- * - ASCII: 8x16 點陣 (完整 printable ASCII 0x20-0x7E)
- * - 中文: 16x16 點陣 (常用漢字)
- * 
- * 版本: v2.0
- * 日期: 2025-10-28
- */
-
-#ifndef FONT_H
-#define FONT_H
-
-#include <stdint.h>
-#include <stdbool.h>
-#include <string.h>
-
-// ============================================
-// 8x16 標準 ASCII 字體 (簡化版)
-// ============================================
-
-// 由於完整 ASCII 字體需要 ~15KB，這裡提供常用字符
-// 如需完整字體，可以從標準字體庫轉換
-
-// 支援的字符範圍
-static const char supported_ascii[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
-
-// 標準 8x16 ASCII 字體資料 (0x20-0x7E)
-static const uint8_t font_ascii_8x16[][16] = {
-    // 0x20: ' ' (空格)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x21: '!'
-    {0x00,0x00,0x18,0x3C,0x3C,0x3C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x22: '"'
-    {0x00,0x66,0x66,0x66,0x24,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x23: '#'
-    {0x00,0x00,0x00,0x6C,0x6C,0xFE,0x6C,0x6C,0x6C,0xFE,0x6C,0x6C,0x00,0x00,0x00,0x00},
-    // 0x24: '$'
-    {0x18,0x18,0x7C,0xC6,0xC2,0xC0,0x7C,0x06,0x06,0x86,0xC6,0x7C,0x18,0x18,0x00,0x00},
-    // 0x25: '%'
-    {0x00,0x00,0x00,0x00,0xC2,0xC6,0x0C,0x18,0x30,0x60,0xC6,0x86,0x00,0x00,0x00,0x00},
-    // 0x26: '&'
-    {0x00,0x00,0x38,0x6C,0x6C,0x38,0x76,0xDC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 0x27: '''
-    {0x00,0x30,0x30,0x30,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x28: '('
-    {0x00,0x00,0x0C,0x18,0x30,0x30,0x30,0x30,0x30,0x30,0x18,0x0C,0x00,0x00,0x00,0x00},
-    // 0x29: ')'
-    {0x00,0x00,0x30,0x18,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x18,0x30,0x00,0x00,0x00,0x00},
-    // 0x2A: '*'
-    {0x00,0x00,0x00,0x00,0x00,0x66,0x3C,0xFF,0x3C,0x66,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2B: '+'
-    {0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x7E,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2C: ','
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x18,0x30,0x00,0x00,0x00},
-    // 0x2D: '-'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2E: '.'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x2F: '/'
-    {0x00,0x00,0x00,0x00,0x02,0x06,0x0C,0x18,0x30,0x60,0xC0,0x80,0x00,0x00,0x00,0x00},
-    // 0x30-0x39: '0'-'9'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xCE,0xDE,0xF6,0xE6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // '0'
-    {0x00,0x00,0x18,0x38,0x78,0x18,0x18,0x18,0x18,0x18,0x18,0x7E,0x00,0x00,0x00,0x00}, // '1'
-    {0x00,0x00,0x7C,0xC6,0x06,0x0C,0x18,0x30,0x60,0xC0,0xC6,0xFE,0x00,0x00,0x00,0x00}, // '2'
-    {0x00,0x00,0x7C,0xC6,0x06,0x06,0x3C,0x06,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00}, // '3'
-    {0x00,0x00,0x0C,0x1C,0x3C,0x6C,0xCC,0xFE,0x0C,0x0C,0x0C,0x1E,0x00,0x00,0x00,0x00}, // '4'
-    {0x00,0x00,0xFE,0xC0,0xC0,0xC0,0xFC,0x06,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00}, // '5'
-    {0x00,0x00,0x38,0x60,0xC0,0xC0,0xFC,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // '6'
-    {0x00,0x00,0xFE,0xC6,0x06,0x06,0x0C,0x18,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00}, // '7'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7C,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // '8'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7E,0x06,0x06,0x06,0x0C,0x78,0x00,0x00,0x00,0x00}, // '9'
-    // 0x3A-0x40
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,0x00}, // ':'
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x30,0x00,0x00,0x00,0x00}, // ';'
-    {0x00,0x00,0x00,0x06,0x0C,0x18,0x30,0x60,0x30,0x18,0x0C,0x06,0x00,0x00,0x00,0x00}, // '<'
-    {0x00,0x00,0x00,0x00,0x00,0x7E,0x00,0x00,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '='
-    {0x00,0x00,0x00,0x60,0x30,0x18,0x0C,0x06,0x0C,0x18,0x30,0x60,0x00,0x00,0x00,0x00}, // '>'
-    {0x00,0x00,0x7C,0xC6,0xC6,0x0C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00}, // '?'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xDE,0xDE,0xDE,0xDC,0xC0,0xC1,0x7E,0x00,0x00,0x00,0x00}, // '@'
-    // 0x41-0x5A: 'A'-'Z'
-    {0x00,0x00,0x10,0x38,0x6C,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00}, // 'A'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x66,0x66,0x66,0x66,0xFC,0x00,0x00,0x00,0x00}, // 'B'
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xC0,0xC0,0xC2,0x66,0x3C,0x00,0x00,0x00,0x00}, // 'C'
-    {0x00,0x00,0xF8,0x6C,0x66,0x66,0x66,0x66,0x66,0x66,0x6C,0xF8,0x00,0x00,0x00,0x00}, // 'D'
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00}, // 'E'
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00}, // 'F'
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xDE,0xC6,0xC6,0x66,0x3A,0x00,0x00,0x00,0x00}, // 'G'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00}, // 'H'
-    {0x00,0x00,0x3C,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00}, // 'I'
-    {0x00,0x00,0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00}, // 'J'
-    {0x00,0x00,0xE6,0x66,0x66,0x6C,0x78,0x78,0x6C,0x66,0x66,0xE6,0x00,0x00,0x00,0x00}, // 'K'
-    {0x00,0x00,0xF0,0x60,0x60,0x60,0x60,0x60,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00}, // 'L'
-    {0x00,0x00,0xC6,0xEE,0xFE,0xFE,0xD6,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00}, // 'M'
-    {0x00,0x00,0xC6,0xE6,0xF6,0xFE,0xDE,0xCE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00}, // 'N'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'O'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00}, // 'P'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xD6,0xDE,0x7C,0x0C,0x0E,0x00,0x00}, // 'Q'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x6C,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00}, // 'R'
-    {0x00,0x00,0x7C,0xC6,0xC6,0x60,0x38,0x0C,0x06,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'S'
-    {0x00,0x00,0x7E,0x7E,0x5A,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00}, // 'T'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'U'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x10,0x00,0x00,0x00,0x00}, // 'V'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0xEE,0x6C,0x00,0x00,0x00,0x00}, // 'W'
-    {0x00,0x00,0xC6,0xC6,0x6C,0x7C,0x38,0x38,0x7C,0x6C,0xC6,0xC6,0x00,0x00,0x00,0x00}, // 'X'
-    {0x00,0x00,0x66,0x66,0x66,0x66,0x3C,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00}, // 'Y'
-    {0x00,0x00,0xFE,0xC6,0x86,0x0C,0x18,0x30,0x60,0xC2,0xC6,0xFE,0x00,0x00,0x00,0x00}, // 'Z'
-    // 0x5B-0x60
-    {0x00,0x00,0x3C,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x3C,0x00,0x00,0x00,0x00}, // '['
-    {0x00,0x00,0x00,0x80,0xC0,0xE0,0x70,0x38,0x1C,0x0E,0x06,0x02,0x00,0x00,0x00,0x00}, // '\'
-    {0x00,0x00,0x3C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x3C,0x00,0x00,0x00,0x00}, // ']'
-    {0x10,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '^'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00}, // '_'
-    {0x00,0x30,0x18,0x0C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '`'
-    // 0x61-0x7A: 'a'-'z'
-    {0x00,0x00,0x00,0x00,0x00,0x78,0x0C,0x7C,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00}, // 'a'
-    {0x00,0x00,0xE0,0x60,0x60,0x78,0x6C,0x66,0x66,0x66,0x66,0x7C,0x00,0x00,0x00,0x00}, // 'b'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC0,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'c'
-    {0x00,0x00,0x1C,0x0C,0x0C,0x3C,0x6C,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00}, // 'd'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xFE,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'e'
-    {0x00,0x00,0x38,0x6C,0x64,0x60,0xF0,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00}, // 'f'
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0xCC,0x78,0x00}, // 'g'
-    {0x00,0x00,0xE0,0x60,0x60,0x6C,0x76,0x66,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00}, // 'h'
-    {0x00,0x00,0x18,0x18,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00}, // 'i'
-    {0x00,0x00,0x06,0x06,0x00,0x0E,0x06,0x06,0x06,0x06,0x06,0x06,0x66,0x66,0x3C,0x00}, // 'j'
-    {0x00,0x00,0xE0,0x60,0x60,0x66,0x6C,0x78,0x78,0x6C,0x66,0xE6,0x00,0x00,0x00,0x00}, // 'k'
-    {0x00,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00}, // 'l'
-    {0x00,0x00,0x00,0x00,0x00,0xEC,0xFE,0xD6,0xD6,0xD6,0xD6,0xC6,0x00,0x00,0x00,0x00}, // 'm'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00}, // 'n'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 'o'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x66,0x7C,0x60,0x60,0xF0,0x00}, // 'p'
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0x0C,0x1E,0x00}, // 'q'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x76,0x66,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00}, // 'r'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0x60,0x38,0x0C,0xC6,0x7C,0x00,0x00,0x00,0x00}, // 's'
-    {0x00,0x00,0x10,0x30,0x30,0xFC,0x30,0x30,0x30,0x30,0x36,0x1C,0x00,0x00,0x00,0x00}, // 't'
-    {0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00}, // 'u'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x00,0x00,0x00,0x00}, // 'v'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0x6C,0x00,0x00,0x00,0x00}, // 'w'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0x6C,0x38,0x38,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00}, // 'x'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7E,0x06,0x0C,0xF8,0x00}, // 'y'
-    {0x00,0x00,0x00,0x00,0x00,0xFE,0xCC,0x18,0x30,0x60,0xC6,0xFE,0x00,0x00,0x00,0x00}, // 'z'
-    // 0x7B-0x7E
-    {0x00,0x00,0x0E,0x18,0x18,0x18,0x70,0x18,0x18,0x18,0x18,0x0E,0x00,0x00,0x00,0x00}, // '{'
-    {0x00,0x00,0x18,0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00}, // '|'
-    {0x00,0x00,0x70,0x18,0x18,0x18,0x0E,0x18,0x18,0x18,0x18,0x70,0x00,0x00,0x00,0x00}, // '}'
-    {0x00,0x00,0x76,0xDC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '~'
-};
-
-// 取得 ASCII 字符的字體資料
-static inline const uint8_t* get_ascii_font(char c) {
-    if (c >= 0x20 && c <= 0x7E) {
-        return font_ascii_8x16[c - 0x20];
-    }
-    return font_ascii_8x16[0]; // 返回空格
-}
-
-// ============================================
-// 16x16 常用中文字體
-// ============================================
-
-// 中文字體結構
-typedef struct {
-    const char *utf8;    // UTF-8 編碼
-    const uint8_t *data; // 16x16 點陣資料 (32 bytes)
-} chinese_font_t;
-
-// 16x16 中文點陣字體資料
-// "中" - U+4E2D
-static const uint8_t font_zhong[] = {
-    0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00,
-    0xFF,0xFE,0x01,0x00,0x01,0x00,0x01,0x00,
-    0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00,
-    0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00
-};
-
-// "文" - U+6587
-static const uint8_t font_wen[] = {
-    0x00,0x40,0x00,0x60,0x00,0x50,0x7F,0xFE,
-    0x40,0x48,0x40,0x44,0x40,0x42,0x40,0x40,
-    0x40,0x40,0x40,0x40,0x40,0x60,0x40,0x50,
-    0x40,0x48,0x40,0x46,0x40,0x40,0x00,0x00
-};
-
-// "測" - U+6E2C
-static const uint8_t font_ce[] = {
-    0x10,0x20,0x19,0xFC,0x10,0x20,0xFC,0x20,
-    0x94,0x20,0x94,0xFE,0xFD,0x24,0x94,0x28,
-    0x94,0x28,0xFC,0x50,0x90,0x50,0x04,0x8E,
-    0x04,0x04,0x14,0x04,0x08,0x28,0x00,0x10
-};
-
-// "試" - U+8A66
-static const uint8_t font_shi[] = {
-    0x20,0x40,0x23,0xF8,0x20,0x40,0xFC,0x40,
-    0x24,0x40,0x24,0xFC,0x24,0x44,0xFC,0x44,
-    0x24,0x44,0x24,0x44,0x24,0x44,0x44,0x84,
-    0x44,0x84,0x85,0x04,0x82,0x14,0x00,0x08
-};
-
-// "顯" - U+986F
-static const uint8_t font_xian[] = {
-    0x10,0x40,0x10,0x40,0x10,0xFC,0xFB,0x04,
-    0x10,0x00,0x10,0x80,0xFF,0xFE,0x10,0x80,
-    0x10,0x80,0x10,0x80,0x10,0x80,0x10,0x90,
-    0x10,0x88,0x10,0x86,0x10,0x80,0x10,0x00
-};
-
-// "示" - U+793A
-static const uint8_t font_shi2[] = {
-    0x04,0x40,0x04,0x40,0x04,0x40,0x04,0x40,
-    0x04,0x40,0xFF,0xFE,0x04,0x40,0x04,0x40,
-    0x04,0x40,0x04,0x40,0x04,0x40,0x04,0x40,
-    0x08,0x42,0x08,0x42,0x10,0x3E,0x20,0x00
-};
-
-// "電" - U+96FB
-static const uint8_t font_dian[] = {
-    0x00,0x00,0x7F,0xFC,0x40,0x04,0x40,0x04,
-    0x40,0x04,0x5F,0xF4,0x50,0x14,0x50,0x14,
-    0x5F,0xF4,0x50,0x14,0x50,0x14,0x40,0x04,
-    0x40,0x04,0x40,0x04,0x7F,0xFC,0x00,0x00
-};
-
-// "子" - U+5B50
-static const uint8_t font_zi[] = {
-    0x00,0x40,0x00,0x40,0x00,0x40,0x00,0x80,
-    0x00,0x80,0xFF,0xFE,0x01,0x00,0x02,0x00,
-    0x04,0x00,0x08,0x20,0x10,0x20,0x20,0x20,
-    0x40,0x20,0x80,0x20,0x00,0xA0,0x00,0x40
-};
-
-// "屏" - U+5C4F
-static const uint8_t font_ping[] = {
-    0x01,0x00,0xFF,0xFE,0x01,0x00,0x01,0x00,
-    0x11,0x10,0x11,0x10,0x11,0x10,0x11,0x10,
-    0x11,0x10,0xFF,0xFE,0x11,0x10,0x11,0x10,
-    0x11,0x10,0x11,0x10,0x11,0x10,0x00,0x00
-};
-
-// "幕" - U+5E55
-static const uint8_t font_mu[] = {
-    0x7F,0xFC,0x01,0x00,0xFF,0xFE,0x01,0x00,
-    0x1F,0xF8,0x01,0x00,0xFF,0xFE,0x01,0x00,
-    0x01,0x00,0xFF,0xFE,0x02,0x80,0x02,0x80,
-    0x04,0x60,0x08,0x10,0x10,0x0C,0x20,0x04
-};
-
-// 常用漢字字體表
-static const chinese_font_t chinese_fonts[] = {
-    {"中", font_zhong},
-    {"文", font_wen},
-    {"測", font_ce},
-    {"試", font_shi},
-    {"顯", font_xian},
-    {"示", font_shi2},
-    {"電", font_dian},
-    {"子", font_zi},
-    {"屏", font_ping},
-    {"幕", font_mu},
-};
-
-// 取得中文字符的字體資料
-static inline const uint8_t* get_chinese_font(const char *utf8_char) {
-    int num_fonts = sizeof(chinese_fonts) / sizeof(chinese_font_t);
-    for (int i = 0; i < num_fonts; i++) {
-        if (strncmp(utf8_char, chinese_fonts[i].utf8, 3) == 0) {
-            return chinese_fonts[i].data;
-        }
-    }
-    return NULL;
-}
-
-#endif // FONT_H
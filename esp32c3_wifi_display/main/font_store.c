@@ -0,0 +1,202 @@
+/*
+ * Flash 字型分區實作
+ *
+ * 版本: v1.2
+ * 日期: 2025-11-19
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "font_store.h"
+
+static const char *TAG = "FontStore";
+
+// 已映射的字型檔
+typedef struct {
+    const font_store_header_t *header;
+    const font_store_entry_t *index;
+    const uint8_t *bitmaps;
+    uint32_t bitmap_size;       // bitmap 區段長度
+    bool compressed;
+} font_store_font_t;
+
+static font_store_font_t fonts[FONT_STORE_MAX_FONTS];
+static int font_count = 0;
+static esp_partition_mmap_handle_t font_mmap_handle;
+
+// ============================================
+// 輔助函數
+// ============================================
+
+/**
+ * 驗證字型檔標頭與各區段都在可用範圍內
+ */
+static esp_err_t validate_header(const font_store_header_t *h, uint32_t available)
+{
+    if (h->magic != FONT_STORE_MAGIC) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (h->version < 1 || h->version > FONT_STORE_VERSION || h->header_size < FONT_STORE_HEADER_SIZE) {
+        ESP_LOGE(TAG, "Unsupported font file version %d", h->version);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (h->file_size > available) {
+        ESP_LOGE(TAG, "Font file (%lu bytes) larger than partition space (%lu bytes)",
+                 h->file_size, available);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint32_t glyph_bytes = (uint32_t)((h->glyph_width + 7) / 8) * h->glyph_height;
+    uint64_t index_end = (uint64_t)h->index_offset + (uint64_t)h->glyph_count * sizeof(font_store_entry_t);
+    if (h->glyph_width == 0 || h->glyph_height == 0 || h->glyph_bytes != glyph_bytes ||
+        h->glyph_width > FONT_STORE_MAX_SIZE || h->glyph_height > FONT_STORE_MAX_SIZE ||
+        index_end > h->bitmap_offset || h->bitmap_offset > h->file_size) {
+        ESP_LOGE(TAG, "Corrupt font file header");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+esp_err_t font_store_init(void)
+{
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, FONT_STORE_PARTITION_SUBTYPE, FONT_STORE_PARTITION);
+    if (partition == NULL) {
+        ESP_LOGW(TAG, "Font partition '%s' not found", FONT_STORE_PARTITION);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const void *ptr;
+    esp_err_t ret = esp_partition_mmap(partition, 0, partition->size,
+                                       ESP_PARTITION_MMAP_DATA, &ptr, &font_mmap_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map font partition: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 依序讀取串接的字型檔
+    const uint8_t *base = (const uint8_t *)ptr;
+    uint32_t offset = 0;
+    font_count = 0;
+    while (font_count < FONT_STORE_MAX_FONTS && offset + FONT_STORE_HEADER_SIZE <= partition->size) {
+        const font_store_header_t *h = (const font_store_header_t *)(base + offset);
+        ret = validate_header(h, partition->size - offset);
+        if (ret != ESP_OK) {
+            break;
+        }
+
+        font_store_font_t *font = &fonts[font_count++];
+        font->header = h;
+        font->index = (const font_store_entry_t *)(base + offset + h->index_offset);
+        font->bitmaps = base + offset + h->bitmap_offset;
+        font->bitmap_size = h->file_size - h->bitmap_offset;
+        font->compressed = (h->version >= 2) && (h->flags & FONT_STORE_FLAG_ROW_RLE);
+
+        ESP_LOGI(TAG, "Font %d at 0x%08lX: %lu glyphs (%dx%d), %lu bytes%s",
+                 font_count - 1, partition->address + offset, h->glyph_count,
+                 h->glyph_width, h->glyph_height, h->file_size,
+                 font->compressed ? ", row RLE" : "");
+
+        // 下一個字型檔 (4 bytes 對齊)
+        if (h->file_size == 0 || (h->file_size & 3) != 0) {
+            break;
+        }
+        offset += h->file_size;
+    }
+
+    if (font_count == 0) {
+        ESP_LOGW(TAG, "No valid font file in partition");
+        esp_partition_munmap(font_mmap_handle);
+        return ret == ESP_OK ? ESP_ERR_NOT_FOUND : ret;
+    }
+    return ESP_OK;
+}
+
+bool font_store_ready(void)
+{
+    return font_count > 0;
+}
+
+bool font_store_find(uint8_t height, uint32_t codepoint, font_store_glyph_t *glyph)
+{
+    for (int f = 0; f < font_count; f++) {
+        const font_store_font_t *font = &fonts[f];
+        const font_store_header_t *h = font->header;
+        if (h->glyph_height != height) {
+            continue;
+        }
+
+        // 索引依碼位排序：二分搜尋
+        int32_t lo = 0;
+        int32_t hi = (int32_t)h->glyph_count - 1;
+        while (lo <= hi) {
+            int32_t mid = lo + (hi - lo) / 2;
+            uint32_t cp = font->index[mid].codepoint;
+            if (cp < codepoint) {
+                lo = mid + 1;
+                continue;
+            }
+            if (cp > codepoint) {
+                hi = mid - 1;
+                continue;
+            }
+
+            // 壓縮字形的長度到下一個字形為止 (最後一個到 bitmap 區段結尾)
+            uint32_t start = font->index[mid].offset;
+            uint32_t end = start + h->glyph_bytes;
+            if (font->compressed) {
+                end = ((uint32_t)mid + 1 < h->glyph_count) ? font->index[mid + 1].offset : font->bitmap_size;
+            }
+            if (start >= end || end > font->bitmap_size) {
+                ESP_LOGE(TAG, "Glyph U+%04lX outside font file", codepoint);
+                return false;
+            }
+
+            glyph->data = font->bitmaps + start;
+            glyph->size = end - start;
+            glyph->width = h->glyph_width;
+            glyph->height = h->glyph_height;
+            glyph->row_bytes = (h->glyph_width + 7) / 8;
+            glyph->compressed = font->compressed;
+            return true;
+        }
+    }
+    return false;
+}
+
+void font_store_reader_init(font_store_reader_t *reader, const font_store_glyph_t *glyph)
+{
+    glyph_rle_reader_init(&reader->rle, glyph->data, glyph->size, glyph->row_bytes);
+    reader->raw = glyph->data;
+    reader->row_bytes = glyph->row_bytes;
+    reader->compressed = glyph->compressed;
+}
+
+esp_err_t font_store_read_row(font_store_reader_t *reader, uint8_t *row)
+{
+    if (reader->compressed) {
+        return glyph_rle_read_row(&reader->rle, row);
+    }
+    memcpy(row, reader->raw, reader->row_bytes);
+    reader->raw += reader->row_bytes;
+    return ESP_OK;
+}
+
+esp_err_t font_store_decode(const font_store_glyph_t *glyph, uint8_t *out, size_t size)
+{
+    size_t glyph_bytes = (size_t)glyph->row_bytes * glyph->height;
+    if (size < glyph_bytes) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (glyph->compressed) {
+        return glyph_rle_decode(glyph->data, glyph->size, glyph->row_bytes, glyph->height, out);
+    }
+    memcpy(out, glyph->data, glyph_bytes);
+    return ESP_OK;
+}
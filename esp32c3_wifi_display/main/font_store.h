@@ -0,0 +1,128 @@
+/*
+ * Flash 字型分區 (Font Store)
+ *
+ * 大型 CJK 字型 (數千到上萬字) 不編譯進韌體，而是存放在獨立的 "font" 分區，
+ * 透過 esp_partition_mmap 映射到位址空間，讀取字形時直接經由 flash cache 存取，
+ * 不佔用 RAM。字型檔由 tools/font_packer.py 產生，可以獨立於韌體更新：
+ *
+ *   python tools/font_packer.py unifont.hex font.bin --range 4E00-9FFF
+ *   parttool.py -p COM4 write_partition --partition-name font --input font.bin
+ *
+ * 分區內可以依序放多個字型檔 (例如 16、24、32 px 三種尺寸)，每個檔案長度為 4 的倍數，
+ * 下一個字型檔緊接在前一個之後 (直接 cat 串接即可)，遇到無效 magic 時結束。
+ *
+ * 字型檔格式 (小端序)：
+ *   header (32 bytes)
+ *     [0-3]   magic "EPFT"
+ *     [4-5]   version (1: 未壓縮, 2: 支援壓縮)
+ *     [6-7]   header size
+ *     [8-11]  glyph count
+ *     [12]    glyph width (px)
+ *     [13]    glyph height (px)
+ *     [14-15] bytes per glyph (未壓縮)
+ *     [16-19] index offset
+ *     [20-23] bitmap offset
+ *     [24-27] file size (含結尾補齊)
+ *     [28-31] flags (version 2；bit 0 = 逐行壓縮)
+ *   index: glyph count 個 { codepoint:u32, offset:u32 }，依碼位排序，
+ *          offset 相對於 bitmap 區段
+ *   bitmap: 每個字形 bytes per glyph，每行 (width + 7) / 8 bytes，高位在左；
+ *           壓縮時每個字形各自以逐行 RLE 編碼 (見 glyph_rle.h)，長度由下一個字形的 offset 決定
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-12
+ */
+
+#ifndef FONT_STORE_H
+#define FONT_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "glyph_rle.h"
+
+#define FONT_STORE_PARTITION        "font"
+#define FONT_STORE_PARTITION_SUBTYPE 0x40
+#define FONT_STORE_MAGIC            0x54465045u     // "EPFT"
+#define FONT_STORE_VERSION          2
+#define FONT_STORE_HEADER_SIZE      32
+#define FONT_STORE_MAX_FONTS        4
+#define FONT_STORE_MAX_SIZE         32              // 字形最大 32x32
+#define FONT_STORE_MAX_GLYPH_BYTES  (FONT_STORE_MAX_SIZE / 8 * FONT_STORE_MAX_SIZE)
+#define FONT_STORE_FLAG_ROW_RLE     0x01
+
+// 字型檔標頭
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t glyph_count;
+    uint8_t glyph_width;
+    uint8_t glyph_height;
+    uint16_t glyph_bytes;
+    uint32_t index_offset;
+    uint32_t bitmap_offset;
+    uint32_t file_size;
+    uint32_t flags;
+} font_store_header_t;
+
+// 索引項目
+typedef struct __attribute__((packed)) {
+    uint32_t codepoint;
+    uint32_t offset;
+} font_store_entry_t;
+
+// 查詢到的字形 (指向映射的 flash)
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;          // 資料長度 (壓縮時為上限)
+    uint8_t width;
+    uint8_t height;
+    uint8_t row_bytes;
+    bool compressed;
+} font_store_glyph_t;
+
+// 逐行讀取字形
+typedef struct {
+    glyph_rle_reader_t rle;
+    const uint8_t *raw;     // 未壓縮時的下一行
+    uint8_t row_bytes;
+    bool compressed;
+} font_store_reader_t;
+
+/**
+ * 尋找並映射字型分區，驗證字型檔
+ * 找不到分區或內容無效時回傳錯誤，之後的查詢都找不到字形
+ */
+esp_err_t font_store_init(void);
+
+/**
+ * 字型分區是否可用
+ */
+bool font_store_ready(void);
+
+/**
+ * 在高度為 height 的字型中尋找碼位
+ *
+ * @return 找到時填入 glyph 並回傳 true
+ */
+bool font_store_find(uint8_t height, uint32_t codepoint, font_store_glyph_t *glyph);
+
+/**
+ * 開始逐行讀取字形 (解壓縮直接輸出到呼叫者的行緩衝區)
+ */
+void font_store_reader_init(font_store_reader_t *reader, const font_store_glyph_t *glyph);
+
+/**
+ * 讀取下一行 (row_bytes bytes)
+ *
+ * @return ESP_ERR_INVALID_SIZE: 壓縮資料損壞
+ */
+esp_err_t font_store_read_row(font_store_reader_t *reader, uint8_t *row);
+
+/**
+ * 解出整個字形 (size 至少為 row_bytes * height)
+ */
+esp_err_t font_store_decode(const font_store_glyph_t *glyph, uint8_t *out, size_t size);
+
+#endif // FONT_STORE_H
@@ -0,0 +1,188 @@
+/*
+ * 字形快取實作
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-12
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "glyph_cache.h"
+
+static const char *TAG = "GlyphCache";
+
+// 雜湊表大小為字形槽的兩倍 (負載 ≤ 50%)，必須是 2 的冪次
+#define TABLE_SIZE      (GLYPH_CACHE_SLOTS * 2)
+#define TABLE_MASK      (TABLE_SIZE - 1)
+#define TABLE_EMPTY     0xFF
+
+#define MAKE_KEY(font_id, cp)   (((uint32_t)(font_id) << 24) | ((cp) & 0x00FFFFFF))
+
+typedef struct {
+    uint32_t key;
+    uint32_t last_use;      // LRU 時間戳記
+    bool used;
+    uint8_t data[GLYPH_CACHE_GLYPH_SIZE];
+} glyph_slot_t;
+
+static glyph_slot_t slots[GLYPH_CACHE_SLOTS];
+static uint8_t table[TABLE_SIZE];      // 字形槽索引，TABLE_EMPTY 表示空位
+static bool table_ready = false;
+static uint32_t use_clock = 0;
+static glyph_cache_stats_t cache_stats;
+
+// ============================================
+// 雜湊表
+// ============================================
+
+static inline uint32_t hash_key(uint32_t key)
+{
+    // Knuth 乘法雜湊
+    return (key * 2654435761u) >> 16;
+}
+
+static void table_init(void)
+{
+    memset(table, TABLE_EMPTY, sizeof(table));
+    memset(slots, 0, sizeof(slots));
+    table_ready = true;
+}
+
+/**
+ * 找出鍵所在的表位置，不存在時回傳 -1
+ */
+static int table_find(uint32_t key)
+{
+    uint32_t pos = hash_key(key) & TABLE_MASK;
+    for (int probe = 0; probe < TABLE_SIZE; probe++) {
+        uint8_t slot = table[pos];
+        if (slot == TABLE_EMPTY) {
+            return -1;
+        }
+        if (slots[slot].key == key) {
+            return (int)pos;
+        }
+        pos = (pos + 1) & TABLE_MASK;
+    }
+    return -1;
+}
+
+static void table_insert(uint32_t key, uint8_t slot)
+{
+    uint32_t pos = hash_key(key) & TABLE_MASK;
+    while (table[pos] != TABLE_EMPTY) {
+        pos = (pos + 1) & TABLE_MASK;
+    }
+    table[pos] = slot;
+}
+
+/**
+ * 刪除表位置 pos，並把之後同一探測鏈上的項目往前移，維持查詢正確 (不需要墓碑)
+ */
+static void table_remove(uint32_t pos)
+{
+    table[pos] = TABLE_EMPTY;
+
+    uint32_t next = (pos + 1) & TABLE_MASK;
+    while (table[next] != TABLE_EMPTY) {
+        uint8_t slot = table[next];
+        uint32_t home = hash_key(slots[slot].key) & TABLE_MASK;
+
+        // home 不在 (pos, next] 之間時，項目可以移到空出來的 pos
+        bool movable = (pos <= next) ? (home <= pos || home > next)
+                                     : (home <= pos && home > next);
+        if (movable) {
+            table[pos] = slot;
+            table[next] = TABLE_EMPTY;
+            pos = next;
+        }
+        next = (next + 1) & TABLE_MASK;
+    }
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+const uint8_t *glyph_cache_lookup(uint8_t font_id, uint32_t codepoint)
+{
+    if (!table_ready) {
+        table_init();
+    }
+
+    int pos = table_find(MAKE_KEY(font_id, codepoint));
+    if (pos < 0) {
+        cache_stats.misses++;
+        return NULL;
+    }
+
+    glyph_slot_t *slot = &slots[table[pos]];
+    slot->last_use = ++use_clock;
+    cache_stats.hits++;
+    return slot->data;
+}
+
+uint8_t *glyph_cache_alloc(uint8_t font_id, uint32_t codepoint)
+{
+    if (!table_ready) {
+        table_init();
+    }
+
+    uint32_t key = MAKE_KEY(font_id, codepoint);
+    int pos = table_find(key);
+    int victim;
+
+    if (pos >= 0) {
+        // 已存在：直接覆寫
+        victim = table[pos];
+    } else {
+        // 找空槽，沒有空槽時淘汰最久未使用的字形
+        victim = -1;
+        uint32_t oldest = UINT32_MAX;
+        for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+            if (!slots[i].used) {
+                victim = i;
+                break;
+            }
+            if (slots[i].last_use < oldest) {
+                oldest = slots[i].last_use;
+                victim = i;
+            }
+        }
+
+        if (slots[victim].used) {
+            table_remove((uint32_t)table_find(slots[victim].key));
+            cache_stats.evictions++;
+        }
+        table_insert(key, (uint8_t)victim);
+    }
+
+    glyph_slot_t *slot = &slots[victim];
+    slot->key = key;
+    slot->used = true;
+    slot->last_use = ++use_clock;
+    return slot->data;
+}
+
+const uint8_t *glyph_cache_insert(uint8_t font_id, uint32_t codepoint, const uint8_t *data, size_t size)
+{
+    if (size > GLYPH_CACHE_GLYPH_SIZE) {
+        return NULL;
+    }
+
+    uint8_t *slot = glyph_cache_alloc(font_id, codepoint);
+    memcpy(slot, data, size);
+    return slot;
+}
+
+void glyph_cache_clear(void)
+{
+    table_init();
+    ESP_LOGI(TAG, "Glyph cache cleared");
+}
+
+void glyph_cache_get_stats(glyph_cache_stats_t *stats)
+{
+    *stats = cache_stats;
+}
@@ -0,0 +1,67 @@
+/*
+ * 字形快取 (Glyph Cache)
+ *
+ * 字形來自 flash 字型分區或壓縮儲存時，每次繪製都要重新讀取/解碼。
+ * 同一畫面上重複的字元 (數字、單位、常用漢字) 改由 RAM 中的小型快取提供：
+ * - 以 (font id, 碼位) 為鍵的開放定址雜湊表 (線性探測，刪除時向後移位，無墓碑)
+ * - 固定數量的字形槽，滿了以 LRU 淘汰
+ * - 累計命中/未命中次數
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-12
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GLYPH_CACHE_SLOTS       64      // 快取的字形數
+#define GLYPH_CACHE_GLYPH_SIZE  32      // 每個字形最多 32 bytes (16x16)
+
+// 字型 id
+typedef enum {
+    GLYPH_FONT_ASCII_8X16 = 0,  // 8x16 ASCII
+    GLYPH_FONT_CJK_16X16,       // 16x16 中文 (內建或 flash 字型分區)
+} glyph_font_id_t;
+
+// 累計統計
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} glyph_cache_stats_t;
+
+/**
+ * 查詢快取
+ *
+ * @return 字形資料，不在快取中時為 NULL；指標在下一次 glyph_cache_insert 前有效
+ */
+const uint8_t *glyph_cache_lookup(uint8_t font_id, uint32_t codepoint);
+
+/**
+ * 將字形複製到快取 (必要時淘汰最久未使用的字形)
+ *
+ * @return 快取中的字形資料；size 超過 GLYPH_CACHE_GLYPH_SIZE 時為 NULL
+ */
+const uint8_t *glyph_cache_insert(uint8_t font_id, uint32_t codepoint, const uint8_t *data, size_t size);
+
+/**
+ * 取得一個可寫入的字形槽 (必要時淘汰最久未使用的字形)，讓壓縮字形直接解碼到快取中
+ *
+ * @return GLYPH_CACHE_GLYPH_SIZE bytes 的字形槽
+ */
+uint8_t *glyph_cache_alloc(uint8_t font_id, uint32_t codepoint);
+
+/**
+ * 清空快取 (例如更換字型檔後)
+ */
+void glyph_cache_clear(void);
+
+/**
+ * 取得累計統計
+ */
+void glyph_cache_get_stats(glyph_cache_stats_t *stats);
+
+#endif // GLYPH_CACHE_H
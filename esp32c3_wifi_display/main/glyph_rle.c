@@ -0,0 +1,65 @@
+/*
+ * 字形逐行壓縮解碼實作
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-12
+ */
+
+#include <string.h>
+#include "glyph_rle.h"
+
+void glyph_rle_reader_init(glyph_rle_reader_t *reader, const uint8_t *src, size_t len, uint8_t row_bytes)
+{
+    reader->src = src;
+    reader->end = src + len;
+    reader->row_bytes = row_bytes;
+    reader->op = GLYPH_RLE_BLANK;
+    reader->remaining = 0;
+    memset(reader->prev, 0, sizeof(reader->prev));
+}
+
+esp_err_t glyph_rle_read_row(glyph_rle_reader_t *reader, uint8_t *row)
+{
+    if (reader->remaining == 0) {
+        if (reader->src >= reader->end) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        uint8_t op = *reader->src++;
+        reader->op = op & GLYPH_RLE_OP_MASK;
+        reader->remaining = (op & GLYPH_RLE_COUNT_MASK) + 1;
+    }
+
+    switch (reader->op) {
+        case GLYPH_RLE_BLANK:
+            memset(reader->prev, 0, reader->row_bytes);
+            break;
+        case GLYPH_RLE_REPEAT:
+            break;
+        case GLYPH_RLE_LITERAL:
+            if ((size_t)(reader->end - reader->src) < reader->row_bytes) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            memcpy(reader->prev, reader->src, reader->row_bytes);
+            reader->src += reader->row_bytes;
+            break;
+        default:
+            return ESP_ERR_INVALID_SIZE;
+    }
+
+    reader->remaining--;
+    memcpy(row, reader->prev, reader->row_bytes);
+    return ESP_OK;
+}
+
+esp_err_t glyph_rle_decode(const uint8_t *src, size_t len, uint8_t row_bytes, uint16_t rows, uint8_t *out)
+{
+    glyph_rle_reader_t reader;
+    glyph_rle_reader_init(&reader, src, len, row_bytes);
+    for (uint16_t r = 0; r < rows; r++) {
+        esp_err_t ret = glyph_rle_read_row(&reader, out + r * row_bytes);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,60 @@
+/*
+ * 字形逐行壓縮 (Glyph Row RLE)
+ *
+ * 點陣字形的冗餘主要在「行」：上下留白是整行空白，粗橫筆與直筆讓相鄰幾行完全相同，
+ * 字形越大越明顯 (24x24、32x32 的標題字)。因此以整行為單位編碼，而不是逐 byte：
+ *
+ *   op byte：高 2 bits 為類型，低 6 bits 為行數 n - 1
+ *     00  n 行空白
+ *     01  重複上一行 n 次 (第一行之前視為空白行)
+ *     10  之後接 n 行原樣資料 (每行 row_bytes bytes)
+ *     11  保留
+ *
+ * 解碼器是串流式的：每次輸出一行點陣直接交給繪圖函數，不需要先解出整個字形。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-12
+ */
+
+#ifndef GLYPH_RLE_H
+#define GLYPH_RLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#define GLYPH_RLE_BLANK         0x00
+#define GLYPH_RLE_REPEAT        0x40
+#define GLYPH_RLE_LITERAL       0x80
+#define GLYPH_RLE_OP_MASK       0xC0
+#define GLYPH_RLE_COUNT_MASK    0x3F
+#define GLYPH_RLE_MAX_ROW_BYTES 4       // 最寬 32 px
+
+// 串流解碼狀態
+typedef struct {
+    const uint8_t *src;
+    const uint8_t *end;
+    uint8_t row_bytes;
+    uint8_t op;             // 目前的 op 類型
+    uint8_t remaining;      // 目前 op 尚未輸出的行數
+    uint8_t prev[GLYPH_RLE_MAX_ROW_BYTES];
+} glyph_rle_reader_t;
+
+/**
+ * 初始化解碼器 (src 在解碼期間必須有效，row_bytes 不可超過 GLYPH_RLE_MAX_ROW_BYTES)
+ */
+void glyph_rle_reader_init(glyph_rle_reader_t *reader, const uint8_t *src, size_t len, uint8_t row_bytes);
+
+/**
+ * 解出下一行
+ *
+ * @return ESP_ERR_INVALID_SIZE: 壓縮資料提前結束或含保留的 op
+ */
+esp_err_t glyph_rle_read_row(glyph_rle_reader_t *reader, uint8_t *row);
+
+/**
+ * 一次解出 rows 行
+ */
+esp_err_t glyph_rle_decode(const uint8_t *src, size_t len, uint8_t row_bytes, uint16_t rows, uint8_t *out);
+
+#endif // GLYPH_RLE_H
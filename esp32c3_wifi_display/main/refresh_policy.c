@@ -0,0 +1,159 @@
+/*
+ * 自適應刷新策略實作
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-05
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "epaper_driver.h"
+#include "refresh_policy.h"
+
+static const char *TAG = "RefreshPolicy";
+
+#define REGION_WIDTH    (EPAPER_WIDTH / REFRESH_POLICY_REGION_COLS)
+#define REGION_HEIGHT   (EPAPER_HEIGHT / REFRESH_POLICY_REGION_ROWS)
+
+static refresh_policy_config_t policy_config = REFRESH_POLICY_DEFAULT_CONFIG();
+
+// 各區域自上次全刷後的部分更新次數
+static uint16_t partial_count[REFRESH_POLICY_REGION_ROWS][REFRESH_POLICY_REGION_COLS];
+
+// 自上次清除殘影後的快速全刷次數
+static uint16_t fast_full_count = 0;
+
+// 上次清除殘影的時間；has_cleaned = false 表示開機後尚未清除過
+static uint32_t last_clean_ms = 0;
+static bool has_cleaned = false;
+
+// ============================================
+// 輔助函數
+// ============================================
+
+static inline uint32_t now_ms(void)
+{
+    return pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
+/**
+ * 計算矩形覆蓋的區域範圍 (包含邊界)
+ */
+static void region_span(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        int *col0, int *row0, int *col1, int *row1)
+{
+    uint32_t x1 = (uint32_t)x + (w ? w - 1 : 0);
+    uint32_t y1 = (uint32_t)y + (h ? h - 1 : 0);
+    if (x1 >= EPAPER_WIDTH) x1 = EPAPER_WIDTH - 1;
+    if (y1 >= EPAPER_HEIGHT) y1 = EPAPER_HEIGHT - 1;
+
+    *col0 = x / REGION_WIDTH;
+    *row0 = y / REGION_HEIGHT;
+    *col1 = x1 / REGION_WIDTH;
+    *row1 = y1 / REGION_HEIGHT;
+
+    if (*col0 >= REFRESH_POLICY_REGION_COLS) *col0 = REFRESH_POLICY_REGION_COLS - 1;
+    if (*row0 >= REFRESH_POLICY_REGION_ROWS) *row0 = REFRESH_POLICY_REGION_ROWS - 1;
+    if (*col1 >= REFRESH_POLICY_REGION_COLS) *col1 = REFRESH_POLICY_REGION_COLS - 1;
+    if (*row1 >= REFRESH_POLICY_REGION_ROWS) *row1 = REFRESH_POLICY_REGION_ROWS - 1;
+}
+
+/**
+ * 全刷時選擇快速全刷或清除殘影全刷
+ */
+static refresh_decision_t select_full(void)
+{
+    if (!has_cleaned) {
+        return REFRESH_FULL_CLEAN;
+    }
+    if (fast_full_count >= policy_config.max_fast_full) {
+        return REFRESH_FULL_CLEAN;
+    }
+    if (now_ms() - last_clean_ms >= policy_config.clean_interval_ms) {
+        return REFRESH_FULL_CLEAN;
+    }
+    return REFRESH_FULL_FAST;
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+void refresh_policy_init(const refresh_policy_config_t *config)
+{
+    if (config != NULL) {
+        policy_config = *config;
+    }
+
+    memset(partial_count, 0, sizeof(partial_count));
+    fast_full_count = 0;
+    last_clean_ms = 0;
+    has_cleaned = false;
+
+    ESP_LOGI(TAG, "Policy: max_partial=%d, max_fast_full=%d, clean_interval=%lu ms, partial_area=%d%%",
+             policy_config.max_partial_per_region, policy_config.max_fast_full,
+             policy_config.clean_interval_ms, policy_config.partial_area_percent);
+}
+
+refresh_decision_t refresh_policy_select(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    // 大面積更新：全刷比部分更新更快也更乾淨
+    uint32_t area = (uint32_t)w * h;
+    uint32_t screen_area = (uint32_t)EPAPER_WIDTH * EPAPER_HEIGHT;
+    if (area * 100 >= screen_area * policy_config.partial_area_percent) {
+        return select_full();
+    }
+
+    // 任一覆蓋區域累計的部分更新次數達上限：殘影過多，改用全刷
+    int col0, row0, col1, row1;
+    region_span(x, y, w, h, &col0, &row0, &col1, &row1);
+    for (int row = row0; row <= row1; row++) {
+        for (int col = col0; col <= col1; col++) {
+            if (partial_count[row][col] >= policy_config.max_partial_per_region) {
+                return select_full();
+            }
+        }
+    }
+
+    return REFRESH_PARTIAL;
+}
+
+void refresh_policy_commit(refresh_decision_t decision, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    switch (decision) {
+        case REFRESH_PARTIAL: {
+            int col0, row0, col1, row1;
+            region_span(x, y, w, h, &col0, &row0, &col1, &row1);
+            for (int row = row0; row <= row1; row++) {
+                for (int col = col0; col <= col1; col++) {
+                    partial_count[row][col]++;
+                }
+            }
+            break;
+        }
+
+        case REFRESH_FULL_FAST:
+            memset(partial_count, 0, sizeof(partial_count));
+            fast_full_count++;
+            break;
+
+        case REFRESH_FULL_CLEAN:
+            memset(partial_count, 0, sizeof(partial_count));
+            fast_full_count = 0;
+            last_clean_ms = now_ms();
+            has_cleaned = true;
+            break;
+    }
+}
+
+const char *refresh_policy_name(refresh_decision_t decision)
+{
+    switch (decision) {
+        case REFRESH_PARTIAL:       return "partial";
+        case REFRESH_FULL_FAST:     return "fast full";
+        case REFRESH_FULL_CLEAN:    return "ghost-clean full";
+        default:                    return "unknown";
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * 自適應刷新策略 (Refresh Policy)
+ *
+ * 取代「每張畫面都先清白再全刷兩次」的固定流程。
+ * 依據各區域累計的部分更新次數與距離上次清除殘影的時間，
+ * 為每次更新選擇：
+ *   - 部分更新 (partial)
+ *   - 快速全刷 (fast full，單次刷新)
+ *   - 清除殘影全刷 (ghost-clean，先刷白再刷新畫面)
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-05
+ */
+
+#ifndef REFRESH_POLICY_H
+#define REFRESH_POLICY_H
+
+#include <stdint.h>
+
+// 區域格線 (800x480 分成 4x3 個 200x160 區域)
+#define REFRESH_POLICY_REGION_COLS      4
+#define REFRESH_POLICY_REGION_ROWS      3
+
+// 預設門檻值
+#define REFRESH_POLICY_MAX_PARTIAL      8           // 同一區域部分更新次數上限
+#define REFRESH_POLICY_MAX_FAST_FULL    10          // 兩次清除殘影之間的快速全刷次數上限
+#define REFRESH_POLICY_CLEAN_INTERVAL   (60 * 60 * 1000)  // 清除殘影最長間隔 (ms)
+#define REFRESH_POLICY_PARTIAL_AREA     60          // 部分更新面積超過螢幕的百分比時改用全刷
+
+// 刷新方式
+typedef enum {
+    REFRESH_PARTIAL = 0,
+    REFRESH_FULL_FAST,
+    REFRESH_FULL_CLEAN,
+} refresh_decision_t;
+
+// 可調整的門檻值
+typedef struct {
+    uint16_t max_partial_per_region;
+    uint16_t max_fast_full;
+    uint32_t clean_interval_ms;
+    uint8_t partial_area_percent;
+} refresh_policy_config_t;
+
+#define REFRESH_POLICY_DEFAULT_CONFIG() {                       \
+    .max_partial_per_region = REFRESH_POLICY_MAX_PARTIAL,       \
+    .max_fast_full = REFRESH_POLICY_MAX_FAST_FULL,              \
+    .clean_interval_ms = REFRESH_POLICY_CLEAN_INTERVAL,         \
+    .partial_area_percent = REFRESH_POLICY_PARTIAL_AREA,        \
+}
+
+/**
+ * 初始化刷新策略
+ * 開機後面板內容未知，第一次全刷一律使用清除殘影全刷
+ *
+ * @param config 門檻值，NULL 表示使用預設值
+ */
+void refresh_policy_init(const refresh_policy_config_t *config);
+
+/**
+ * 為即將更新的區域選擇刷新方式 (不修改狀態)
+ */
+refresh_decision_t refresh_policy_select(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+/**
+ * 刷新完成後記錄實際使用的刷新方式
+ */
+void refresh_policy_commit(refresh_decision_t decision, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+/**
+ * 刷新方式名稱 (日誌用)
+ */
+const char *refresh_policy_name(refresh_decision_t decision);
+
+#endif // REFRESH_POLICY_H
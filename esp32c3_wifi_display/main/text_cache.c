@@ -0,0 +1,201 @@
+/*
+ * 文字點陣快取實作
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "text_cache.h"
+
+static const char *TAG = "TextCache";
+
+// 快取項目 (一次配置：標頭 + 字串 + 點陣)
+typedef struct {
+    uint32_t hash;
+    uint32_t last_use;      // LRU 時間戳記
+    uint16_t width;
+    uint16_t height;
+    uint16_t size;          // 整個項目的 bytes
+    uint8_t font_id;
+    uint8_t len;            // 字串長度
+    uint8_t data[];         // 字串 (不含 '\0') 後接點陣
+} text_entry_t;
+
+static text_entry_t *entries[TEXT_CACHE_MAX_ENTRIES];
+static uint32_t seen[TEXT_CACHE_SEEN_SLOTS];   // 第一次使用的字串雜湊 (0 = 空)
+static uint8_t seen_next = 0;
+static uint32_t use_clock = 0;
+static text_cache_stats_t cache_stats;
+
+// ============================================
+// 輔助函數
+// ============================================
+
+/**
+ * FNV-1a 雜湊 (含 font id)
+ */
+static uint32_t hash_key(uint8_t font_id, const char *str, size_t len)
+{
+    uint32_t h = 2166136261u ^ font_id;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)str[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int find_entry(uint8_t font_id, const char *str, size_t len, uint32_t hash)
+{
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+        const text_entry_t *e = entries[i];
+        if (e != NULL && e->hash == hash && e->font_id == font_id &&
+            e->len == len && memcmp(e->data, str, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void remove_entry(int index)
+{
+    cache_stats.bytes -= entries[index]->size;
+    cache_stats.entries--;
+    free(entries[index]);
+    entries[index] = NULL;
+}
+
+/**
+ * 淘汰最久未使用的項目
+ */
+static bool evict_oldest(void)
+{
+    int oldest = -1;
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i] != NULL && (oldest < 0 || entries[i]->last_use < entries[oldest]->last_use)) {
+            oldest = i;
+        }
+    }
+    if (oldest < 0) {
+        return false;
+    }
+    remove_entry(oldest);
+    cache_stats.evictions++;
+    return true;
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+const uint8_t *text_cache_lookup(uint8_t font_id, const char *str, uint16_t *width, uint16_t *height)
+{
+    size_t len = strlen(str);
+    if (len > TEXT_CACHE_MAX_LEN) {
+        return NULL;
+    }
+
+    int index = find_entry(font_id, str, len, hash_key(font_id, str, len));
+    if (index < 0) {
+        cache_stats.misses++;
+        return NULL;
+    }
+
+    text_entry_t *e = entries[index];
+    e->last_use = ++use_clock;
+    cache_stats.hits++;
+    *width = e->width;
+    *height = e->height;
+    return e->data + e->len;
+}
+
+bool text_cache_admit(uint8_t font_id, const char *str)
+{
+    size_t len = strlen(str);
+    if (len == 0 || len > TEXT_CACHE_MAX_LEN) {
+        return false;
+    }
+
+    uint32_t hash = hash_key(font_id, str, len);
+    if (hash == 0) {
+        hash = 1;
+    }
+    for (int i = 0; i < TEXT_CACHE_SEEN_SLOTS; i++) {
+        if (seen[i] == hash) {
+            seen[i] = 0;
+            return true;
+        }
+    }
+
+    // 環狀覆寫最舊的記錄
+    seen[seen_next] = hash;
+    seen_next = (seen_next + 1) % TEXT_CACHE_SEEN_SLOTS;
+    cache_stats.deferred++;
+    return false;
+}
+
+uint8_t *text_cache_alloc(uint8_t font_id, const char *str, uint16_t width, uint16_t height)
+{
+    size_t len = strlen(str);
+    size_t bitmap_bytes = (size_t)(width + 7) / 8 * height;
+    size_t size = sizeof(text_entry_t) + len + bitmap_bytes;
+    if (len == 0 || len > TEXT_CACHE_MAX_LEN || size > TEXT_CACHE_BUDGET) {
+        return NULL;
+    }
+
+    uint32_t hash = hash_key(font_id, str, len);
+    int index = find_entry(font_id, str, len, hash);
+    if (index >= 0) {
+        remove_entry(index);
+    }
+
+    // 騰出預算與項目欄位
+    while (cache_stats.bytes + size > TEXT_CACHE_BUDGET || cache_stats.entries >= TEXT_CACHE_MAX_ENTRIES) {
+        if (!evict_oldest()) {
+            break;
+        }
+    }
+
+    text_entry_t *e = (text_entry_t *)calloc(1, size);
+    if (e == NULL) {
+        ESP_LOGW(TAG, "No memory for %u-byte text bitmap", (unsigned)size);
+        return NULL;
+    }
+
+    e->hash = hash;
+    e->last_use = ++use_clock;
+    e->width = width;
+    e->height = height;
+    e->size = (uint16_t)size;
+    e->font_id = font_id;
+    e->len = (uint8_t)len;
+    memcpy(e->data, str, len);
+
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i] == NULL) {
+            entries[i] = e;
+            break;
+        }
+    }
+    cache_stats.bytes += size;
+    cache_stats.entries++;
+    return e->data + len;
+}
+
+void text_cache_clear(void)
+{
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i] != NULL) {
+            remove_entry(i);
+        }
+    }
+    memset(seen, 0, sizeof(seen));
+    seen_next = 0;
+    ESP_LOGI(TAG, "Text cache cleared");
+}
+
+void text_cache_get_stats(text_cache_stats_t *stats)
+{
+    *stats = cache_stats;
+}
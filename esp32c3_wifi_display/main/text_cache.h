@@ -0,0 +1,72 @@
+/*
+ * 文字點陣快取 (Text Bitmap Cache)
+ *
+ * 儀表板每次更新都會重畫相同的標籤與單位 ("°C"、星期、"km/h"…)，
+ * 每個字都要重新查字形、逐字繪製。這裡把整個字串渲染後的 1bpp 點陣快取起來，
+ * 下次繪製同一字串時只需要一次 bitmap blit：
+ * - 以 (font id, 字串) 為鍵，保存字串副本，比對時不會誤判
+ * - 總用量受 TEXT_CACHE_BUDGET 限制，超過時以 LRU 淘汰
+ * - 第二次使用才放入快取，只出現一次的字串 (時間、數值) 不會擠掉常用的標籤
+ * - 過長的字串不快取 (由呼叫者逐字繪製)
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define TEXT_CACHE_BUDGET       (6 * 1024)  // 所有項目 (點陣 + 字串 + 標頭) 的總 bytes
+#define TEXT_CACHE_MAX_ENTRIES  32
+#define TEXT_CACHE_MAX_LEN      48          // 可快取的字串長度上限 (bytes)
+#define TEXT_CACHE_SEEN_SLOTS   32          // 記住最近第一次使用的字串數 (只存雜湊)
+
+// 字型 id
+#define TEXT_CACHE_FONT_16      0           // 內建 16 px 字型 (epaper_draw_string)
+
+// 累計統計
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t deferred;      // 第一次使用、未放入快取的次數
+    uint32_t bytes;         // 目前使用的 bytes
+    uint16_t entries;       // 目前的項目數
+} text_cache_stats_t;
+
+/**
+ * 查詢快取
+ *
+ * @param width, height  點陣尺寸 (px)，每行 (width + 7) / 8 bytes，高位在左
+ * @return 點陣資料，不在快取中時為 NULL；指標在下一次 text_cache_alloc 前有效
+ */
+const uint8_t *text_cache_lookup(uint8_t font_id, const char *str, uint16_t *width, uint16_t *height);
+
+/**
+ * 未命中時決定是否放入快取：第一次使用只記下雜湊並回傳 false (呼叫者直接逐字繪製)，
+ * 最近 TEXT_CACHE_SEEN_SLOTS 個第一次使用的字串再次出現時回傳 true
+ */
+bool text_cache_admit(uint8_t font_id, const char *str);
+
+/**
+ * 配置一個新項目 (必要時淘汰最久未使用的項目)，呼叫者把字串渲染到回傳的點陣中
+ *
+ * @return 已清為 0 的點陣；字串過長、點陣超過預算或記憶體不足時為 NULL
+ */
+uint8_t *text_cache_alloc(uint8_t font_id, const char *str, uint16_t width, uint16_t height);
+
+/**
+ * 清空快取 (例如字型改變後)
+ */
+void text_cache_clear(void);
+
+/**
+ * 取得統計
+ */
+void text_cache_get_stats(text_cache_stats_t *stats);
+
+#endif // TEXT_CACHE_H
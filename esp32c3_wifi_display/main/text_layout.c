@@ -0,0 +1,335 @@
+/*
+ * 文字排版引擎實作
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "utf8.h"
+#include "text_layout.h"
+
+static const char *TAG = "TextLayout";
+
+// ============================================
+// 禁則 (kinsoku)
+// ============================================
+
+// 不可出現在行首的字元 (句讀點、右括號、小假名、長音等)
+static const uint32_t no_line_start[] = {
+    ')', ',', '.', ':', ';', '?', '!', ']', '}', '%',
+    0x2019, 0x201D, 0x2026, 0x2025,                             // ’ ” … ‥
+    0x3001, 0x3002, 0x3005, 0x3009, 0x300B, 0x300D, 0x300F,     // 、 。 々 〉 》 」 』
+    0x3011, 0x3015, 0x3017, 0x3019, 0x301F,                     // 】 〕 〗 〙 〟
+    0x3041, 0x3043, 0x3045, 0x3047, 0x3049, 0x3063, 0x3083,     // ぁ ぃ ぅ ぇ ぉ っ ゃ
+    0x3085, 0x3087, 0x308E, 0x30A1, 0x30A3, 0x30A5, 0x30A7,     // ゅ ょ ゎ ァ ィ ゥ ェ
+    0x30A9, 0x30C3, 0x30E3, 0x30E5, 0x30E7, 0x30EE, 0x30F5,     // ォ ッ ャ ュ ョ ヮ ヵ
+    0x30F6, 0x30FB, 0x30FC,                                     // ヶ ・ ー
+    0xFE50, 0xFE51, 0xFE52,                                     // ﹐ ﹑ ﹒
+    0xFF01, 0xFF09, 0xFF0C, 0xFF0E, 0xFF1A, 0xFF1B, 0xFF1F,     // ！ ） ， ． ： ； ？
+    0xFF3D, 0xFF5D, 0xFF5E,                                     // ］ ｝ ～
+};
+
+// 不可出現在行尾的字元 (左括號、左引號)
+static const uint32_t no_line_end[] = {
+    '(', '[', '{',
+    0x2018, 0x201C,                                             // ‘ “
+    0x3008, 0x300A, 0x300C, 0x300E, 0x3010, 0x3014, 0x3016,     // 〈 《 「 『 【 〔 〖
+    0x3018, 0x301D,                                             // 〘 〝
+    0xFF08, 0xFF3B, 0xFF5B,                                     // （ ［ ｛
+};
+
+static bool in_set(const uint32_t *set, size_t n, uint32_t cp)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (set[i] == cp) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#define IS_NO_LINE_START(cp)    in_set(no_line_start, sizeof(no_line_start) / sizeof(no_line_start[0]), (cp))
+#define IS_NO_LINE_END(cp)      in_set(no_line_end, sizeof(no_line_end) / sizeof(no_line_end[0]), (cp))
+
+static inline bool is_wide(uint32_t cp)
+{
+    return epaper_glyph_advance(cp) == 16;
+}
+
+/**
+ * prev 與 cur 之間 (不含空白) 是否可以換行
+ * 英文單字中間不可換行 (連字號之後除外)；全形字元前後都可以換行，但需遵守禁則
+ */
+static bool can_break_between(uint32_t prev, uint32_t cur)
+{
+    if (IS_NO_LINE_START(cur) || IS_NO_LINE_END(prev)) {
+        return false;
+    }
+    if (prev == '-') {
+        return true;
+    }
+    return is_wide(prev) || is_wide(cur);
+}
+
+// ============================================
+// 字形量測
+// ============================================
+
+/**
+ * 字形的前進寬度與左側偏移 (已放大)
+ */
+static uint8_t glyph_metrics(uint32_t cp, const text_style_t *style, int8_t *bearing)
+{
+    uint8_t scale = style->scale ? style->scale : 1;
+    *bearing = 0;
+
+    if (!style->proportional || cp >= 0x80) {
+        return epaper_glyph_advance(cp) * scale;
+    }
+    if (cp == ' ') {
+        return TEXT_SPACE_ADVANCE * scale;
+    }
+
+    uint8_t left, width;
+    if (!epaper_glyph_ink(cp, &left, &width)) {
+        return epaper_glyph_advance(cp) * scale;
+    }
+    *bearing = -(int8_t)(left * scale);
+    return (width + style->letter_spacing) * scale;
+}
+
+uint16_t text_measure(const char *str, const text_style_t *style)
+{
+    uint32_t width = 0;
+    const char *p = str;
+
+    while (*p != '\0') {
+        int8_t bearing;
+        width += glyph_metrics(utf8_next(&p), style, &bearing);
+        if (width >= UINT16_MAX) {
+            return UINT16_MAX;
+        }
+    }
+    return (uint16_t)width;
+}
+
+// ============================================
+// 排版
+// ============================================
+
+/**
+ * 本行最後一個字形的右緣 (行寬，不含行尾空白)
+ */
+static uint16_t line_ink_width(const text_layout_t *out, uint16_t line_first)
+{
+    if (out->count <= line_first) {
+        return 0;
+    }
+    const text_glyph_t *last = &out->glyphs[out->count - 1];
+    return (uint16_t)(last->x + last->advance);
+}
+
+/**
+ * 結束一行：字形 [first, end) 放在第 line_count 行
+ *
+ * @return 方框放不下這一行時回傳 false
+ */
+static bool finish_line(text_layout_t *out, uint16_t first, uint16_t end, uint16_t width,
+                        uint16_t line_height, uint16_t glyph_height, uint16_t box_h)
+{
+    if (out->line_count >= TEXT_LAYOUT_MAX_LINES ||
+        (uint32_t)out->line_count * line_height + glyph_height > box_h) {
+        return false;
+    }
+
+    text_line_t *line = &out->lines[out->line_count];
+    line->first = first;
+    line->count = end - first;
+    line->width = width;
+
+    int16_t y = (int16_t)(out->line_count * line_height);
+    for (uint16_t i = first; i < end; i++) {
+        out->glyphs[i].y = y;
+    }
+
+    out->line_count++;
+    return true;
+}
+
+esp_err_t text_layout(const char *str, const text_style_t *style,
+                      uint16_t box_w, uint16_t box_h, text_align_t align,
+                      text_glyph_t *glyphs, uint16_t capacity, text_layout_t *out)
+{
+    if (str == NULL || style == NULL || out == NULL || (glyphs == NULL && capacity > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->glyphs = glyphs;
+    out->capacity = capacity;
+    out->scale = style->scale ? style->scale : 1;
+
+    uint16_t glyph_height = 16 * out->scale;
+    uint16_t line_height = glyph_height + style->line_spacing;
+
+    uint16_t line_first = 0;    // 本行第一個字形
+    int32_t pen_x = 0;
+    int32_t brk = -1;           // 換行點：下一行第一個字形的索引
+    uint16_t brk_width = 0;     // 在換行點斷行時本行的寬度
+    uint32_t prev = 0;          // 前一個字元
+    bool after_space = false;
+    bool wrapped = false;       // 本行是自動換行產生的 (行首空白略過)
+    const char *p = str;
+
+    while (*p != '\0') {
+        uint32_t cp = utf8_next(&p);
+
+        // 強制換行
+        if (cp == '\n') {
+            if (!finish_line(out, line_first, out->count, line_ink_width(out, line_first),
+                             line_height, glyph_height, box_h)) {
+                out->count = line_first;
+                out->truncated = true;
+                break;
+            }
+            line_first = out->count;
+            pen_x = 0;
+            brk = -1;
+            prev = 0;
+            after_space = false;
+            wrapped = false;
+            continue;
+        }
+
+        int8_t bearing;
+        uint8_t advance = glyph_metrics(cp, style, &bearing);
+
+        // 空白：記錄換行點，只推進位置不產生字形
+        if (cp == ' ') {
+            if (out->count > line_first) {
+                if (!after_space) {
+                    brk = out->count;
+                    brk_width = line_ink_width(out, line_first);
+                }
+                pen_x += advance;
+            } else if (!wrapped) {
+                pen_x += advance;   // 段落開頭的縮排
+            }
+            after_space = true;
+            prev = cp;
+            continue;
+        }
+
+        // 字元之間的換行點 (中文逐字，英文只在連字號之後)
+        if (!after_space && out->count > line_first && can_break_between(prev, cp)) {
+            brk = out->count;
+            brk_width = line_ink_width(out, line_first);
+        }
+        after_space = false;
+
+        // 超出方框寬度：在最後一個換行點斷行，沒有換行點時強制在這個字元前斷行
+        if (pen_x + advance > box_w && out->count > line_first) {
+            uint16_t end;
+            uint16_t width;
+            if (brk > line_first) {
+                end = (uint16_t)brk;
+                width = brk_width;
+            } else {
+                end = out->count;
+                width = line_ink_width(out, line_first);
+            }
+
+            if (!finish_line(out, line_first, end, width, line_height, glyph_height, box_h)) {
+                out->count = line_first;
+                out->truncated = true;
+                break;
+            }
+
+            // 換行點之後的字形移到下一行開頭
+            int32_t shift = (end < out->count) ? out->glyphs[end].x : pen_x;
+            for (uint16_t i = end; i < out->count; i++) {
+                out->glyphs[i].x -= shift;
+            }
+            pen_x -= shift;
+            line_first = end;
+            brk = -1;
+            wrapped = true;
+        }
+
+        if (out->count >= out->capacity) {
+            // 字形陣列已滿：保留已排好的部分 (方框放不下這一行時捨棄這一行)
+            if (!finish_line(out, line_first, out->count, line_ink_width(out, line_first),
+                             line_height, glyph_height, box_h)) {
+                out->count = line_first;
+            }
+            out->truncated = true;
+            break;
+        }
+
+        text_glyph_t *g = &out->glyphs[out->count++];
+        g->codepoint = cp;
+        g->x = (int16_t)pen_x;
+        g->y = 0;
+        g->advance = advance;
+        pen_x += advance;
+        prev = cp;
+    }
+
+    // 最後一行
+    if (!out->truncated && (out->count > line_first || out->line_count == 0)) {
+        if (!finish_line(out, line_first, out->count, line_ink_width(out, line_first),
+                         line_height, glyph_height, box_h)) {
+            out->count = line_first;
+            out->truncated = true;
+        }
+    }
+
+    // 對齊並套用比例字型的左側偏移
+    for (uint16_t l = 0; l < out->line_count; l++) {
+        text_line_t *line = &out->lines[l];
+        int32_t offset = 0;
+        if (line->width < box_w) {
+            if (align == TEXT_ALIGN_CENTER) {
+                offset = (box_w - line->width) / 2;
+            } else if (align == TEXT_ALIGN_RIGHT) {
+                offset = box_w - line->width;
+            }
+        }
+
+        for (uint16_t i = line->first; i < line->first + line->count; i++) {
+            int8_t bearing;
+            glyph_metrics(out->glyphs[i].codepoint, style, &bearing);
+            out->glyphs[i].x += (int16_t)(offset + bearing);
+        }
+
+        if (line->width > out->width) {
+            out->width = line->width;
+        }
+    }
+
+    out->height = out->line_count ? (out->line_count * line_height - style->line_spacing) : 0;
+
+    if (out->truncated) {
+        ESP_LOGW(TAG, "Text truncated to %d lines in %dx%d box", out->line_count, box_w, box_h);
+    }
+    return ESP_OK;
+}
+
+// ============================================
+// 繪製
+// ============================================
+
+void text_render(epaper_t *epaper, uint16_t x, uint16_t y, const text_layout_t *layout, uint8_t color)
+{
+    for (uint16_t i = 0; i < layout->count; i++) {
+        const text_glyph_t *g = &layout->glyphs[i];
+        int32_t gx = (int32_t)x + g->x;
+        int32_t gy = (int32_t)y + g->y;
+        if (gx < 0 || gy < 0 || gx > UINT16_MAX || gy > UINT16_MAX) {
+            continue;   // 其餘由 viewport 的裁切矩形裁切
+        }
+        epaper_draw_glyph_scaled(epaper, (uint16_t)gx, (uint16_t)gy, g->codepoint, layout->scale, color);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * 文字排版引擎 (Text Layout)
+ *
+ * 在指定的方框內排版 UTF-8 文字：
+ * - 每個字形有自己的前進寬度 (比例字型：ASCII 依字形實際墨跡寬度)
+ * - 多種字體大小 (整數倍放大)
+ * - 英文以單字換行，中文逐字換行並遵守禁則 (句號、逗號、右括號等不可在行首，
+ *   左括號不可在行尾)
+ * - 靠左 / 置中 / 靠右對齊
+ *
+ * 排版結果是一串已定位的字形 (glyph run)，繪製時不需要重新量測。
+ * 字形陣列由呼叫者提供，排版過程不配置記憶體。
+ *
+ * 版本: v1.0
+ * 日期: 2025-11-11
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "epaper_driver.h"
+
+#define TEXT_LAYOUT_MAX_LINES   32
+#define TEXT_SPACE_ADVANCE      4       // 比例字型的空白寬度 (px，未放大)
+
+// 對齊方式
+typedef enum {
+    TEXT_ALIGN_LEFT = 0,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT,
+} text_align_t;
+
+// 文字樣式
+typedef struct {
+    uint8_t scale;          // 字體放大倍數 (1 = 16 px 高)
+    bool proportional;      // ASCII 使用比例寬度
+    uint8_t letter_spacing; // 比例字型的字距 (px，未放大)
+    uint8_t line_spacing;   // 行距 (px)
+} text_style_t;
+
+#define TEXT_STYLE_DEFAULT() {      \
+    .scale = 1,                     \
+    .proportional = false,          \
+    .letter_spacing = 1,            \
+    .line_spacing = 2,              \
+}
+
+// 已定位的字形 (座標相對於方框左上角)
+typedef struct {
+    uint32_t codepoint;
+    int16_t x;              // 字形格的左上角 (已扣除比例字型的左側空白)
+    int16_t y;
+    uint8_t advance;        // 前進寬度 (px，已放大)
+} text_glyph_t;
+
+// 一行
+typedef struct {
+    uint16_t first;         // 第一個字形的索引
+    uint16_t count;         // 字形數
+    uint16_t width;         // 行寬 (px，不含行尾空白)
+} text_line_t;
+
+// 排版結果
+typedef struct {
+    text_glyph_t *glyphs;   // 呼叫者提供的字形陣列
+    uint16_t capacity;
+    uint16_t count;
+    text_line_t lines[TEXT_LAYOUT_MAX_LINES];
+    uint16_t line_count;
+    uint16_t width;         // 最寬一行的寬度
+    uint16_t height;        // 總高度
+    uint8_t scale;
+    bool truncated;         // 方框或字形陣列放不下全部文字
+} text_layout_t;
+
+/**
+ * 量測單行文字寬度 (不換行，'\n' 視為一般字元)
+ */
+uint16_t text_measure(const char *str, const text_style_t *style);
+
+/**
+ * 在 box_w x box_h 的方框內排版
+ *
+ * @param glyphs   字形陣列 (capacity 個)
+ * @param out      排版結果；放不下的文字會被截斷並設定 truncated
+ */
+esp_err_t text_layout(const char *str, const text_style_t *style,
+                      uint16_t box_w, uint16_t box_h, text_align_t align,
+                      text_glyph_t *glyphs, uint16_t capacity, text_layout_t *out);
+
+/**
+ * 繪製排版結果 (方框左上角在 x, y)
+ */
+void text_render(epaper_t *epaper, uint16_t x, uint16_t y, const text_layout_t *layout, uint8_t color);
+
+#endif // TEXT_LAYOUT_H
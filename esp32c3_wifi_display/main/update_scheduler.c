@@ -0,0 +1,386 @@
+/*
+ * 部分更新排程器實作
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "update_scheduler.h"
+
+static const char *TAG = "UpdateSched";
+
+#define SCHEDULER_TASK_STACK    4096
+#define SCHEDULER_TASK_PRIO     5
+
+static update_scheduler_config_t sched_config = UPDATE_SCHEDULER_DEFAULT_CONFIG();
+static epaper_t *sched_epaper = NULL;
+static TaskHandle_t sched_task = NULL;
+
+// 面板鎖：SPI 傳輸、刷新與 framebuffer 修改
+static SemaphoreHandle_t panel_mutex = NULL;
+
+// 每個待處理矩形涵蓋的請求 (與 pending[] 同索引)
+typedef struct {
+    uint16_t requests;      // 併入這個矩形的請求數
+    update_tag_t tag;       // 其中最新請求的回報資訊
+} pending_info_t;
+
+// 待處理請求 (由 pending_mutex 保護)
+static SemaphoreHandle_t pending_mutex = NULL;
+static update_rect_t pending[UPDATE_SCHEDULER_MAX_RECTS];
+static pending_info_t pending_info[UPDATE_SCHEDULER_MAX_RECTS];
+static int pending_count = 0;
+
+// ============================================
+// 成本模型
+// ============================================
+
+/**
+ * 部分更新實際傳輸的位元組數
+ * x 方向對齊到位元組，且 0x24 寫入後還要同步 0x26
+ */
+static inline uint32_t rect_transfer_bytes(const update_rect_t *r)
+{
+    uint32_t bytes_per_row = (uint32_t)(r->x + r->w + 7) / 8 - r->x / 8;
+    return bytes_per_row * r->h * 2;
+}
+
+/**
+ * 刷新一個矩形的預估時間 (ns)
+ * 大面積會被刷新策略改為全刷：傳輸整個畫面並使用全刷時間
+ */
+static uint64_t rect_cost_ns(const update_rect_t *r, const update_cost_t *cost)
+{
+    uint32_t area = (uint32_t)r->w * r->h;
+    uint32_t screen_area = (uint32_t)EPAPER_WIDTH * EPAPER_HEIGHT;
+    if (area * 100 >= screen_area * cost->full_area_percent) {
+        return (uint64_t)cost->full_refresh_us * 1000 +
+               (uint64_t)(EPAPER_WIDTH / 8) * EPAPER_HEIGHT * 2 * cost->byte_ns;
+    }
+    return (uint64_t)cost->partial_refresh_us * 1000 + (uint64_t)rect_transfer_bytes(r) * cost->byte_ns;
+}
+
+static update_rect_t rect_union(const update_rect_t *a, const update_rect_t *b)
+{
+    uint32_t x0 = a->x < b->x ? a->x : b->x;
+    uint32_t y0 = a->y < b->y ? a->y : b->y;
+    uint32_t ax1 = (uint32_t)a->x + a->w;
+    uint32_t ay1 = (uint32_t)a->y + a->h;
+    uint32_t bx1 = (uint32_t)b->x + b->w;
+    uint32_t by1 = (uint32_t)b->y + b->h;
+    uint32_t x1 = ax1 > bx1 ? ax1 : bx1;
+    uint32_t y1 = ay1 > by1 ? ay1 : by1;
+
+    update_rect_t u = {
+        .x = (uint16_t)x0,
+        .y = (uint16_t)y0,
+        .w = (uint16_t)(x1 - x0),
+        .h = (uint16_t)(y1 - y0),
+    };
+    return u;
+}
+
+static inline bool rect_contains(const update_rect_t *outer, const update_rect_t *inner)
+{
+    return inner->x >= outer->x && inner->y >= outer->y &&
+           (uint32_t)inner->x + inner->w <= (uint32_t)outer->x + outer->w &&
+           (uint32_t)inner->y + inner->h <= (uint32_t)outer->y + outer->h;
+}
+
+/**
+ * 把 src 的請求資訊併入 dst，保留較新的請求
+ */
+static void info_merge(pending_info_t *dst, const pending_info_t *src)
+{
+    if (src->requests == 0) {
+        return;
+    }
+    if (dst->requests == 0 || src->tag.start_us >= dst->tag.start_us) {
+        dst->tag = src->tag;
+    }
+    dst->requests += src->requests;
+}
+
+/**
+ * update_scheduler_merge 的實作，info 不為 NULL 時跟著矩形一起合併
+ */
+static int merge_rects(update_rect_t *rects, pending_info_t *info, int count, const update_cost_t *cost)
+{
+    // 貪婪合併：每次合併省最多時間的一對，直到沒有任何合併能省時間
+    while (count > 1) {
+        int best_i = -1, best_j = -1;
+        int64_t best_gain = 0;
+
+        for (int i = 0; i < count; i++) {
+            for (int j = i + 1; j < count; j++) {
+                update_rect_t u = rect_union(&rects[i], &rects[j]);
+                int64_t gain = (int64_t)(rect_cost_ns(&rects[i], cost) + rect_cost_ns(&rects[j], cost)) -
+                               (int64_t)rect_cost_ns(&u, cost);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+
+        if (best_i < 0) {
+            break;
+        }
+
+        rects[best_i] = rect_union(&rects[best_i], &rects[best_j]);
+        rects[best_j] = rects[--count];
+        if (info != NULL) {
+            info_merge(&info[best_i], &info[best_j]);
+            info[best_j] = info[count];
+        }
+    }
+
+    return count;
+}
+
+int update_scheduler_merge(update_rect_t *rects, int count, const update_cost_t *cost)
+{
+    return merge_rects(rects, NULL, count, cost);
+}
+
+/**
+ * 彙總多個矩形的請求資訊 (請求數總和與最新請求的回報資訊)
+ */
+static pending_info_t info_total(const pending_info_t *info, int count)
+{
+    pending_info_t total = {0};
+    for (int i = 0; i < count; i++) {
+        info_merge(&total, &info[i]);
+    }
+    return total;
+}
+
+/**
+ * profile 的平均刷新時間，尚無量測值時使用預設值
+ */
+static uint32_t profile_refresh_us(epaper_lut_profile_t profile, uint32_t default_us)
+{
+    if (sched_epaper != NULL) {
+        const epaper_lut_stats_t *ps = &sched_epaper->profile_stats[profile];
+        if (ps->count > 0) {
+            return ps->total_us / ps->count;
+        }
+    }
+    return default_us;
+}
+
+/**
+ * 目前的成本模型參數
+ */
+static update_cost_t current_cost(void)
+{
+    update_cost_t cost = {
+        .partial_refresh_us = sched_config.default_refresh_us,
+        .full_refresh_us = sched_config.default_full_us,
+        .byte_ns = sched_config.byte_ns,
+        .full_area_percent = sched_config.full_area_percent,
+    };
+    if (sched_epaper != NULL) {
+        cost.partial_refresh_us = profile_refresh_us(sched_epaper->partial_profile, cost.partial_refresh_us);
+        cost.full_refresh_us = profile_refresh_us(EPAPER_LUT_FAST_FULL, cost.full_refresh_us);
+    }
+    return cost;
+}
+
+// ============================================
+// 排程任務
+// ============================================
+
+static void update_scheduler_task(void *arg)
+{
+    update_rect_t batch[UPDATE_SCHEDULER_MAX_RECTS];
+
+    while (1) {
+        // 等待第一個請求，再等時間窗收集後續請求
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(sched_config.window_ms));
+
+        update_scheduler_lock();
+
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        int count = pending_count;
+        pending_info_t total = info_total(pending_info, count);
+        memcpy(batch, pending, count * sizeof(update_rect_t));
+        pending_count = 0;
+        xSemaphoreGive(pending_mutex);
+
+        if (count == 0) {
+            // 已被 update_scheduler_refresh_now 處理
+            update_scheduler_unlock();
+            continue;
+        }
+
+        if (sched_epaper != NULL) {
+            epaper_stats_reset(sched_epaper);
+        }
+
+        update_cost_t cost = current_cost();
+        int refreshes = update_scheduler_merge(batch, count, &cost);
+        ESP_LOGI(TAG, "Batch: %d requests -> %d refreshes (partial est. %lu ms)",
+                 total.requests, refreshes, cost.partial_refresh_us / 1000);
+
+        for (int i = 0; i < refreshes; i++) {
+            sched_config.refresh(&batch[i], sched_config.ctx);
+        }
+
+        // 釋放鎖之後其他任務可能重設統計，先取快照
+        epaper_stats_t stats = {0};
+        if (sched_epaper != NULL) {
+            stats = sched_epaper->stats;
+        }
+
+        update_scheduler_unlock();
+
+        if (sched_config.batch_done != NULL) {
+            sched_config.batch_done(&total.tag, total.requests, (uint16_t)refreshes, &stats, sched_config.ctx);
+        }
+    }
+}
+
+// ============================================
+// 公開 API
+// ============================================
+
+esp_err_t update_scheduler_init(epaper_t *epaper, const update_scheduler_config_t *config)
+{
+    if (config == NULL || config->refresh == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sched_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    sched_config = *config;
+    sched_epaper = epaper;
+    pending_count = 0;
+
+    panel_mutex = xSemaphoreCreateMutex();
+    pending_mutex = xSemaphoreCreateMutex();
+    if (panel_mutex == NULL || pending_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(update_scheduler_task, "update_sched", SCHEDULER_TASK_STACK,
+                    NULL, SCHEDULER_TASK_PRIO, &sched_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create scheduler task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Update scheduler started: window=%lu ms, max_rects=%d",
+             sched_config.window_ms, UPDATE_SCHEDULER_MAX_RECTS);
+    return ESP_OK;
+}
+
+esp_err_t update_scheduler_submit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const update_tag_t *tag)
+{
+    if (tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sched_task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (w == 0 || h == 0) {
+        return ESP_OK;
+    }
+
+    update_rect_t rect = { .x = x, .y = y, .w = w, .h = h };
+    pending_info_t info = { .requests = 1, .tag = *tag };
+
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+
+    bool first = (pending_count == 0);
+
+    if (pending_count == UPDATE_SCHEDULER_MAX_RECTS) {
+        // 已滿：先嘗試合併，仍然滿時併入外接矩形增加最少的那一個
+        update_cost_t cost = current_cost();
+        pending_count = merge_rects(pending, pending_info, pending_count, &cost);
+    }
+
+    if (pending_count < UPDATE_SCHEDULER_MAX_RECTS) {
+        pending[pending_count] = rect;
+        pending_info[pending_count] = info;
+        pending_count++;
+    } else {
+        int best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (int i = 0; i < pending_count; i++) {
+            update_rect_t u = rect_union(&pending[i], &rect);
+            uint32_t growth = rect_transfer_bytes(&u) - rect_transfer_bytes(&pending[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        pending[best] = rect_union(&pending[best], &rect);
+        info_merge(&pending_info[best], &info);
+    }
+
+    xSemaphoreGive(pending_mutex);
+
+    // 只有時間窗的第一個請求需要喚醒任務
+    if (first) {
+        xTaskNotifyGive(sched_task);
+    }
+    return ESP_OK;
+}
+
+void update_scheduler_refresh_now(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    update_rect_t rect = { .x = x, .y = y, .w = w, .h = h };
+    pending_info_t dropped = {0};
+
+    if (pending_mutex != NULL) {
+        // 移除會被這次刷新完全覆蓋的請求，留下的請求保留各自的回報資訊
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        int kept = 0;
+        for (int i = 0; i < pending_count; i++) {
+            if (rect_contains(&rect, &pending[i])) {
+                info_merge(&dropped, &pending_info[i]);
+            } else {
+                pending[kept] = pending[i];
+                pending_info[kept] = pending_info[i];
+                kept++;
+            }
+        }
+        pending_count = kept;
+        xSemaphoreGive(pending_mutex);
+    }
+
+    sched_config.refresh(&rect, sched_config.ctx);
+
+    // 被移除的請求由這次刷新完成：以其中最新的請求回報 (統計由呼叫者重設，包含這次刷新)
+    if (dropped.requests > 0 && sched_config.batch_done != NULL) {
+        ESP_LOGI(TAG, "Folded %d pending requests into immediate refresh", dropped.requests);
+        epaper_stats_t stats = {0};
+        if (sched_epaper != NULL) {
+            stats = sched_epaper->stats;
+        }
+        sched_config.batch_done(&dropped.tag, dropped.requests, 1, &stats, sched_config.ctx);
+    }
+}
+
+void update_scheduler_lock(void)
+{
+    if (panel_mutex != NULL) {
+        xSemaphoreTake(panel_mutex, portMAX_DELAY);
+    }
+}
+
+void update_scheduler_unlock(void)
+{
+    if (panel_mutex != NULL) {
+        xSemaphoreGive(panel_mutex);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * 部分更新排程器 (Update Scheduler)
+ *
+ * 每次 epaper_display_partial 都是一次完整的刷新週期 (約 400 ms)。
+ * 多個小工具在短時間內各自更新時，排程器先收集一段時間窗內的請求，
+ * 再依成本模型 (傳輸位元組 vs 額外刷新次數) 合併重疊或相近的矩形，
+ * 以最少的刷新次數完成所有更新。
+ *
+ * 所有面板操作 (SPI / 刷新) 都由排程器的鎖保護；
+ * 其他任務修改 framebuffer 或直接刷新前需先呼叫 update_scheduler_lock()。
+ *
+ * 版本: v1.1
+ * 日期: 2025-11-19
+ */
+
+#ifndef UPDATE_SCHEDULER_H
+#define UPDATE_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "epaper_driver.h"
+
+// 預設值
+#define UPDATE_SCHEDULER_WINDOW_MS      100     // 收集請求的時間窗 (ms)
+#define UPDATE_SCHEDULER_MAX_RECTS      16      // 時間窗內最多保留的矩形數
+#define UPDATE_SCHEDULER_REFRESH_US     400000  // 尚無量測值時的部分刷新時間 (µs)
+#define UPDATE_SCHEDULER_FULL_US        1500000 // 尚無量測值時的全刷時間 (µs)
+#define UPDATE_SCHEDULER_BYTE_NS        2000    // 每位元組 SPI 傳輸時間 (ns，4 MHz)
+#define UPDATE_SCHEDULER_FULL_AREA      60      // 面積超過螢幕百分比時刷新策略會改用全刷
+
+// 待刷新的矩形
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} update_rect_t;
+
+// 請求的回報資訊 (batch_done 會收到這批最後一個請求的資訊)
+typedef struct {
+    uint16_t seq_id;        // 觸發更新的封包 seq_id
+    int64_t start_us;       // 開始處理請求的時間
+    uint32_t rx_us;         // 接收時間
+    uint32_t parse_us;      // 解析 / 繪製時間
+    uint32_t bytes;         // 接收位元組數 (含標頭)
+    uint32_t glyph_hits;    // 繪製時字形快取命中數
+    uint32_t glyph_misses;  // 繪製時字形快取未命中數
+} update_tag_t;
+
+// 合併成本模型參數
+typedef struct {
+    uint32_t partial_refresh_us;    // 一次部分刷新的時間
+    uint32_t full_refresh_us;       // 一次全刷的時間
+    uint32_t byte_ns;               // 每位元組傳輸時間
+    uint8_t full_area_percent;      // 合併後面積達此比例會變成全刷
+} update_cost_t;
+
+/**
+ * 刷新一個 (合併後的) 矩形，framebuffer 已是最新內容
+ * 呼叫時排程器的鎖已被持有
+ */
+typedef void (*update_refresh_fn_t)(const update_rect_t *rect, void *ctx);
+
+/**
+ * 一批請求完成 (由排程任務呼叫時鎖已釋放；
+ * update_scheduler_refresh_now 回報被覆蓋的請求時鎖仍由其呼叫者持有)
+ *
+ * @param tag       這批中最後一個請求的回報資訊
+ * @param requests  這批合併的請求數
+ * @param refreshes 實際執行的刷新次數
+ * @param stats     這批刷新的面板統計 (釋放鎖之前的快照)
+ */
+typedef void (*update_batch_fn_t)(const update_tag_t *tag, uint16_t requests, uint16_t refreshes,
+                                  const epaper_stats_t *stats, void *ctx);
+
+typedef struct {
+    uint32_t window_ms;
+    uint32_t default_refresh_us;
+    uint32_t default_full_us;
+    uint32_t byte_ns;
+    uint8_t full_area_percent;      // 需與刷新策略的 partial_area_percent 一致
+    update_refresh_fn_t refresh;
+    update_batch_fn_t batch_done;   // 可為 NULL
+    void *ctx;
+} update_scheduler_config_t;
+
+#define UPDATE_SCHEDULER_DEFAULT_CONFIG() {                     \
+    .window_ms = UPDATE_SCHEDULER_WINDOW_MS,                    \
+    .default_refresh_us = UPDATE_SCHEDULER_REFRESH_US,          \
+    .default_full_us = UPDATE_SCHEDULER_FULL_US,                \
+    .byte_ns = UPDATE_SCHEDULER_BYTE_NS,                        \
+    .full_area_percent = UPDATE_SCHEDULER_FULL_AREA,            \
+    .refresh = NULL,                                            \
+    .batch_done = NULL,                                         \
+    .ctx = NULL,                                                \
+}
+
+/**
+ * 初始化排程器並啟動排程任務
+ *
+ * @param epaper 用於取得實際量測的刷新時間
+ * @param config refresh 回呼不可為 NULL
+ */
+esp_err_t update_scheduler_init(epaper_t *epaper, const update_scheduler_config_t *config);
+
+/**
+ * 提交一個部分更新請求 (不阻塞刷新)
+ * 第一個請求開始計時，時間窗結束後一併刷新
+ *
+ * @param tag 回報資訊 (會被複製)，batch_done 會收到最後一個請求的資訊
+ */
+esp_err_t update_scheduler_submit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const update_tag_t *tag);
+
+/**
+ * 立即刷新指定區域 (例如全螢幕更新)，被完全覆蓋的待處理請求一併移除
+ * 並在刷新後以 batch_done 回報 (refreshes 為 1)；其餘請求保留在時間窗內
+ * 呼叫者需已持有鎖，且在鎖定後已重設面板統計
+ */
+void update_scheduler_refresh_now(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+/**
+ * 取得 / 釋放面板鎖 (修改 framebuffer 或直接操作面板前使用)
+ */
+void update_scheduler_lock(void);
+void update_scheduler_unlock(void);
+
+/**
+ * 依成本模型合併矩形 (就地修改，回傳合併後的數量)
+ *
+ * 分開刷新的成本為各自的刷新時間 + 傳輸時間；合併後只刷新一次，
+ * 但需要傳輸外接矩形中原本不需要的部分，且面積過大時會變成全刷。
+ * 合併能省時才合併。
+ */
+int update_scheduler_merge(update_rect_t *rects, int count, const update_cost_t *cost);
+
+#endif // UPDATE_SCHEDULER_H
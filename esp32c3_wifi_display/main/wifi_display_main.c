@@ -16,6 +16,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -25,9 +26,17 @@
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_sleep.h"
 #include "esp_websocket_client.h"
 #include "nvs_flash.h"
 #include "epaper_driver.h"
+#include "draw_commands.h"
+#include "refresh_policy.h"
+#include "update_scheduler.h"
+#include "font_store.h"
+#include "glyph_cache.h"
+#include "text_cache.h"
 #include "lwip/sockets.h"
 #include "lwip/netdb.h"
 
@@ -54,9 +63,44 @@
 #define PROTO_TYPE_TILE         0x02    // 分區更新
 #define PROTO_TYPE_DELTA        0x03    // 差分更新
 #define PROTO_TYPE_CMD          0x04    // 控制指令
+#define PROTO_TYPE_DRAW         0x05    // 繪圖指令串流（見 draw_commands.h）
+#define PROTO_TYPE_CHUNK        0x06    // 以位移定址的分段傳輸（可續傳）
 #define PROTO_TYPE_ACK          0x10    // 確認
 #define PROTO_TYPE_NAK          0x11    // 否認
 
+// ACK 狀態碼（ACK payload 第 1 byte；無 payload 表示一般確認）
+#define ACK_STATUS_UNCHANGED    0x01    // 畫面與目前顯示內容相同，未刷新
+#define ACK_STATUS_NEED_FULL    0x02    // framebuffer 與面板不同步，未繪製；請先送出 FULL 畫面
+
+// CMD 封包 (payload 第 1 byte 為指令)
+#define CMD_SLEEP               0x01    // 面板與 ESP32 進入深度睡眠：seconds:u32 (0 = 不以計時器喚醒)
+#define PROTO_TYPE_HELLO        0x20    // 能力協商（連線時由裝置發送）
+#define PROTO_TYPE_TELEMETRY    0x21    // 每次更新後的延遲統計
+#define PROTO_TYPE_RESUME       0x22    // 續傳狀態（已收到的 frame id 與位移）
+
+// 能力協商 (HELLO) 封包
+#define PROTO_VERSION           2
+#define HELLO_PAYLOAD_SIZE      37
+#define DISPLAY_BIT_DEPTH       1       // 1bpp 黑白
+#define RX_WINDOW_PACKETS       1       // 一次只處理一個封包（收完才 ACK）
+
+// 支援的封包類型（bit n = type n）
+#define SUPPORTED_PAYLOAD_TYPES ((1u << PROTO_TYPE_FULL) | \
+                                 (1u << PROTO_TYPE_CMD)  | \
+                                 (1u << PROTO_TYPE_DRAW) | \
+                                 (1u << PROTO_TYPE_CHUNK))
+
+// 支援的編碼方式（bitmask）
+#define CODEC_RAW               (1u << 0)   // 未壓縮 1bpp
+#define SUPPORTED_CODECS        (CODEC_RAW)
+
+// 遙測 (TELEMETRY) 封包
+#define TELEMETRY_PAYLOAD_SIZE  45
+
+// 分段傳輸 (CHUNK) 與續傳 (RESUME) 封包
+#define CHUNK_HEADER_SIZE       10      // frame_id:u16 + total:u32 + offset:u32
+#define RESUME_PAYLOAD_SIZE     10      // frame_id:u16 + offset:u32 + total:u32
+
 // 顯示器尺寸定義
 #define DISPLAY_WIDTH           800
 #define DISPLAY_HEIGHT          480
@@ -98,6 +142,34 @@ typedef struct {
 // static uint8_t *tile_buffer = NULL;  // 已移除（改用完整畫面模式）
 static uint32_t packet_buffer_pos = 0;
 static uint8_t packet_buffer[50000];  // 50KB 封包接收緩衝（足夠容納 48KB 完整畫面 + 標頭）
+
+// 分段傳輸組裝狀態
+// 斷線時保留，重新連線後以 RESUME 封包通知 Server 從已收到的位移繼續傳送
+typedef struct {
+    uint8_t *buffer;        // 組裝中的內層封包（標頭 + payload），收完後釋放
+    uint16_t frame_id;
+    uint32_t total;         // 內層封包總長度
+    uint32_t received;      // 已連續收到的位元組數
+    uint32_t payload_hash;  // 內層 payload 的累加雜湊（不含標頭）
+    int64_t start_us;       // 收到第一個分段的時間
+} chunk_frame_t;
+
+static chunk_frame_t chunk_frame = {0};
+
+// 最後一個已完成的 frame：最後分段的 ACK 遺失時 Server 會重送，
+// 直接 ACK 而不當成新 frame 重新配置緩衝與要求整張重送
+static struct {
+    uint16_t frame_id;
+    uint32_t total;
+    bool valid;
+} chunk_done = {0};
+
+// 接收計時（遙測用）
+static int64_t rx_start_us = 0;       // 收到封包第一個片段的時間
+static uint32_t rx_duration_us = 0;   // 最近一個完整封包的接收時間
+
+// 接收中封包 payload（不含標頭）的累加雜湊，邊收邊算，與 epaper.frame_hash 相同演算法
+static uint32_t rx_payload_hash = EPAPER_HASH_SEED;
 // static uint16_t last_tile_seq_id = 0;  // 已移除（tile 模式廢棄）
 
 // 舊版緩衝區已移除
@@ -304,6 +376,155 @@ static bool parse_packet_header(const uint8_t *data, packet_header_t *header)
     return true;
 }
 
+/**
+ * 寫入小端序整數
+ */
+static inline void write_u16_le(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+}
+
+static inline void write_u32_le(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+/**
+ * 發送能力協商 (HELLO) 封包
+ * 
+ * Payload 格式（小端序，37 bytes）：
+ *   [0]     protocol version
+ *   [1-2]   panel width
+ *   [3-4]   panel height
+ *   [5]     bit depth
+ *   [6-9]   supported payload types (bit n = type n)
+ *   [10-13] supported codecs (bitmask)
+ *   [14-17] maximum packet payload size
+ *   [18-19] receive window (packets in flight)
+ *   [20-23] free heap
+ *   [24-27] current framebuffer hash (0 = unknown)
+ *   [28-31] boot to first panel SPI transaction (µs)
+ *   [32-35] panel init duration (µs)
+ *   [36]    warm start (1 = woke from deep sleep, panel kept the last frame)
+ */
+static void send_hello(void)
+{
+    uint8_t packet[PROTO_HEADER_SIZE + HELLO_PAYLOAD_SIZE];
+    uint8_t *payload = packet + PROTO_HEADER_SIZE;
+    
+    packet[0] = PROTO_HEADER;
+    packet[1] = PROTO_TYPE_HELLO;
+    write_u16_le(&packet[2], 0);
+    write_u32_le(&packet[4], HELLO_PAYLOAD_SIZE);
+    
+    payload[0] = PROTO_VERSION;
+    write_u16_le(&payload[1], DISPLAY_WIDTH);
+    write_u16_le(&payload[3], DISPLAY_HEIGHT);
+    payload[5] = DISPLAY_BIT_DEPTH;
+    write_u32_le(&payload[6], SUPPORTED_PAYLOAD_TYPES);
+    write_u32_le(&payload[10], SUPPORTED_CODECS);
+    write_u32_le(&payload[14], sizeof(packet_buffer) - PROTO_HEADER_SIZE);
+    write_u16_le(&payload[18], RX_WINDOW_PACKETS);
+    write_u32_le(&payload[20], esp_get_free_heap_size());
+    write_u32_le(&payload[24], epaper.frame_hash);
+    write_u32_le(&payload[28], epaper.wake_to_spi_us);
+    write_u32_le(&payload[32], epaper.init_us);
+    payload[36] = epaper.warm_start ? 1 : 0;
+    
+    esp_websocket_client_send_bin(ws_client, (char*)packet, sizeof(packet), portMAX_DELAY);
+    ESP_LOGI(TAG, "Sent HELLO: proto v%d, %dx%d, types=0x%08lX, codecs=0x%08lX, hash=0x%08lX",
+             PROTO_VERSION, DISPLAY_WIDTH, DISPLAY_HEIGHT,
+             (uint32_t)SUPPORTED_PAYLOAD_TYPES, (uint32_t)SUPPORTED_CODECS, epaper.frame_hash);
+}
+
+/**
+ * 發送遙測 (TELEMETRY) 封包
+ * 在每次畫面更新後發送，讓 Server 統計整個裝置群的延遲分佈
+ * 
+ * Payload 格式（小端序，45 bytes，時間單位皆為微秒）：
+ *   [0-3]   receive duration (第一個片段到完整封包)
+ *   [4-7]   parse/decode duration
+ *   [8-11]  SPI transfer duration
+ *   [12-15] BUSY wait duration
+ *   [16-19] total update duration (解析到刷新完成)
+ *   [20]    last refresh mode (epaper_refresh_mode_t)
+ *   [21]    refresh cycle count
+ *   [22-25] bytes received (含標頭)
+ *   [26-29] free heap
+ *   [30-33] minimum free heap
+ *   [34]    last waveform profile (epaper_lut_profile_t)
+ *   [35]    panel temperature (int8, °C)
+ *   [36]    fast refresh temperature register value (°C)
+ *   [37-40] glyphs served from the glyph cache (觸發更新的封包繪製時)
+ *   [41-44] glyphs fetched from font storage (cache misses)
+ * 
+ * 標頭的 seq_id 與觸發此更新的封包相同；總時間從 tag->start_us 算到發送時
+ * 
+ * @param stats 面板統計快照 (需在釋放排程器的鎖之前取得)
+ */
+static void send_telemetry(const update_tag_t *tag, const epaper_stats_t *stats)
+{
+    uint32_t update_us = (uint32_t)(esp_timer_get_time() - tag->start_us);
+    uint8_t packet[PROTO_HEADER_SIZE + TELEMETRY_PAYLOAD_SIZE];
+    uint8_t *payload = packet + PROTO_HEADER_SIZE;
+    
+    packet[0] = PROTO_HEADER;
+    packet[1] = PROTO_TYPE_TELEMETRY;
+    write_u16_le(&packet[2], tag->seq_id);
+    write_u32_le(&packet[4], TELEMETRY_PAYLOAD_SIZE);
+    
+    write_u32_le(&payload[0], tag->rx_us);
+    write_u32_le(&payload[4], tag->parse_us);
+    write_u32_le(&payload[8], stats->spi_us);
+    write_u32_le(&payload[12], stats->busy_us);
+    write_u32_le(&payload[16], update_us);
+    payload[20] = (uint8_t)stats->last_refresh;
+    payload[21] = stats->refresh_count;
+    write_u32_le(&payload[22], tag->bytes);
+    write_u32_le(&payload[26], esp_get_free_heap_size());
+    write_u32_le(&payload[30], esp_get_minimum_free_heap_size());
+    payload[34] = (uint8_t)stats->last_profile;
+    payload[35] = (uint8_t)stats->panel_temperature;
+    payload[36] = stats->fast_temperature;
+    write_u32_le(&payload[37], tag->glyph_hits);
+    write_u32_le(&payload[41], tag->glyph_misses);
+    
+    esp_websocket_client_send_bin(ws_client, (char*)packet, sizeof(packet), portMAX_DELAY);
+    ESP_LOGI(TAG, "Telemetry: rx=%lu us, parse=%lu us, spi=%lu us, busy=%lu us, total=%lu us",
+             tag->rx_us, tag->parse_us, stats->spi_us, stats->busy_us, update_us);
+}
+
+/**
+ * 發送續傳 (RESUME) 封包
+ * 
+ * Payload 格式（小端序，10 bytes）：
+ *   [0-1]   frame id
+ *   [2-5]   已連續收到的位移（Server 應從此位移繼續傳送）
+ *   [6-9]   frame 總長度
+ */
+static void send_resume(void)
+{
+    uint8_t packet[PROTO_HEADER_SIZE + RESUME_PAYLOAD_SIZE];
+    uint8_t *payload = packet + PROTO_HEADER_SIZE;
+    
+    packet[0] = PROTO_HEADER;
+    packet[1] = PROTO_TYPE_RESUME;
+    write_u16_le(&packet[2], 0);
+    write_u32_le(&packet[4], RESUME_PAYLOAD_SIZE);
+    
+    write_u16_le(&payload[0], chunk_frame.frame_id);
+    write_u32_le(&payload[2], chunk_frame.received);
+    write_u32_le(&payload[6], chunk_frame.total);
+    
+    esp_websocket_client_send_bin(ws_client, (char*)packet, sizeof(packet), portMAX_DELAY);
+    ESP_LOGI(TAG, "Sent RESUME: frame_id=%d, offset=%lu/%lu",
+             chunk_frame.frame_id, chunk_frame.received, chunk_frame.total);
+}
+
 /**
  * 發送 ACK
  */
@@ -323,6 +544,43 @@ static void send_ack(uint16_t seq_id)
     ESP_LOGI(TAG, "Sent ACK for seq_id: %d", seq_id);
 }
 
+/**
+ * 發送帶狀態碼的 ACK
+ */
+static void send_ack_status(uint16_t seq_id, uint8_t status)
+{
+    uint8_t ack_packet[PROTO_HEADER_SIZE + 1];
+    ack_packet[0] = PROTO_HEADER;
+    ack_packet[1] = PROTO_TYPE_ACK;
+    ack_packet[2] = seq_id & 0xFF;
+    ack_packet[3] = (seq_id >> 8) & 0xFF;
+    ack_packet[4] = 1;
+    ack_packet[5] = 0;
+    ack_packet[6] = 0;
+    ack_packet[7] = 0;
+    ack_packet[8] = status;
+    
+    esp_websocket_client_send_bin(ws_client, (char*)ack_packet, sizeof(ack_packet), portMAX_DELAY);
+    ESP_LOGI(TAG, "Sent ACK for seq_id: %d (status=0x%02X)", seq_id, status);
+}
+
+/**
+ * 累加計算封包 payload 雜湊
+ * data 為封包中從 offset 開始的片段，跳過前 PROTO_HEADER_SIZE bytes 標頭
+ */
+static uint32_t payload_hash_update(uint32_t hash, uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    if (offset < PROTO_HEADER_SIZE) {
+        uint32_t skip = PROTO_HEADER_SIZE - offset;
+        if (len <= skip) {
+            return hash;
+        }
+        data += skip;
+        len -= skip;
+    }
+    return epaper_hash_update(hash, data, len);
+}
+
 /**
  * 發送 NAK
  */
@@ -426,10 +684,61 @@ static void handle_tile_update(const uint8_t *payload, uint32_t length, uint16_t
 }
 #endif  // 0
 
+/**
+ * 依刷新策略刷新指定區域（framebuffer 需已更新，呼叫時需持有排程器的鎖）
+ */
+static void refresh_region(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    refresh_decision_t decision = refresh_policy_select(x, y, w, h);
+    ESP_LOGI(TAG, "Refresh policy: %s (x=%d, y=%d, w=%d, h=%d)",
+             refresh_policy_name(decision), x, y, w, h);
+    
+    switch (decision) {
+        case REFRESH_PARTIAL:
+            epaper_display_partial(&epaper, x, y, w, h);
+            break;
+            
+        case REFRESH_FULL_CLEAN:
+            // 以完整波形刷白移除殘影（不影響 framebuffer），再快速全刷新畫面
+            epaper_set_refresh_profile(&epaper, EPAPER_LUT_GHOST_CLEAN);
+            epaper_clear_panel(&epaper, COLOR_WHITE);
+            epaper_set_refresh_profile(&epaper, EPAPER_LUT_FAST_FULL);
+            epaper_display_full(&epaper);
+            break;
+            
+        case REFRESH_FULL_FAST:
+        default:
+            epaper_set_refresh_profile(&epaper, EPAPER_LUT_FAST_FULL);
+            epaper_display_full(&epaper);
+            break;
+    }
+    
+    refresh_policy_commit(decision, x, y, w, h);
+}
+
+/**
+ * 排程器回呼：刷新合併後的矩形
+ */
+static void scheduler_refresh(const update_rect_t *rect, void *ctx)
+{
+    refresh_region(rect->x, rect->y, rect->w, rect->h);
+}
+
+/**
+ * 排程器回呼：一批部分更新完成，以最後一個請求的解析時間與位元組數回報這批的刷新時間
+ */
+static void scheduler_batch_done(const update_tag_t *tag, uint16_t requests, uint16_t refreshes,
+                                 const epaper_stats_t *stats, void *ctx)
+{
+    ESP_LOGI(TAG, "Coalesced %d draw updates into %d refreshes", requests, refreshes);
+    send_telemetry(tag, stats);
+}
+
 /**
  * 處理完整螢幕更新
  */
-static void handle_full_update(const uint8_t *payload, uint32_t length, uint16_t seq_id)
+static void handle_full_update(const uint8_t *payload, uint32_t length, uint16_t seq_id,
+                               uint32_t payload_hash)
 {
     ESP_LOGI(TAG, "========================================");
     ESP_LOGI(TAG, "Full Screen Update (800x480)");
@@ -446,20 +755,48 @@ static void handle_full_update(const uint8_t *payload, uint32_t length, uint16_t
     }
     
     uint32_t start_time = xTaskGetTickCount();
+    update_tag_t tag = {
+        .seq_id = seq_id,
+        .start_us = esp_timer_get_time(),
+        .rx_us = rx_duration_us,
+        .bytes = PROTO_HEADER_SIZE + length,
+    };
+    epaper_stats_t stats;
     
-    ESP_LOGI(TAG, "Step 1: Clearing screen to remove ghosting...");
-    // 清除 E-Paper 顯示器（移除殘影）
-    memset(epaper.framebuffer, 0xFF, EPAPER_BUFFER_SIZE);  // 全白
-    epaper_display_full(&epaper);
-    vTaskDelay(pdMS_TO_TICKS(800));  // 等待清除完成
+    // 等待排程器目前的刷新結束（統計與 framebuffer 都由鎖保護）
+    update_scheduler_lock();
+    epaper_stats_reset(&epaper);
+    
+    // 與目前顯示的畫面相同（重新連線或定期同步時常見）：跳過刷新
+    // 雜湊相同時再以 framebuffer 比對確認，避免雜湊碰撞；
+    // 暖啟動後 framebuffer 尚未載入面板上的畫面，只能依雜湊判斷，並以收到的畫面補上 framebuffer
+    if (epaper.frame_hash != 0 && payload_hash == epaper.frame_hash &&
+        (!epaper.framebuffer_synced || memcmp(epaper.framebuffer, payload, FULL_SCREEN_SIZE) == 0)) {
+        if (!epaper.framebuffer_synced) {
+            memcpy(epaper.framebuffer, payload, FULL_SCREEN_SIZE);
+            epaper.framebuffer_synced = true;
+        }
+        ESP_LOGI(TAG, "Frame unchanged (hash=0x%08lX), skipping refresh", payload_hash);
+        stats = epaper.stats;
+        update_scheduler_unlock();
+        send_ack_status(seq_id, ACK_STATUS_UNCHANGED);
+        send_telemetry(&tag, &stats);
+        esp_websocket_client_send_text(ws_client, "READY", 5, portMAX_DELAY);
+        ESP_LOGI(TAG, "========================================");
+        return;
+    }
     
-    ESP_LOGI(TAG, "Step 2: Writing new image data (48000 bytes)...");
+    ESP_LOGI(TAG, "Step 1: Writing new image data (48000 bytes)...");
     // 直接複製完整圖片數據到 framebuffer（無需額外緩衝區）
+    int64_t parse_start_us = esp_timer_get_time();
     memcpy(epaper.framebuffer, payload, FULL_SCREEN_SIZE);
+    tag.parse_us = (uint32_t)(esp_timer_get_time() - parse_start_us);
     
-    ESP_LOGI(TAG, "Step 3: Displaying full screen...");
-    // 執行完整更新
-    epaper_display_full(&epaper);
+    ESP_LOGI(TAG, "Step 2: Displaying full screen...");
+    // 由刷新策略決定快速全刷或先清除殘影；尚未刷新的部分更新一併取消
+    update_scheduler_refresh_now(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    stats = epaper.stats;
+    update_scheduler_unlock();
     
     uint32_t elapsed = pdTICKS_TO_MS(xTaskGetTickCount() - start_time);
     ESP_LOGI(TAG, "Full screen update completed in %lu ms", elapsed);
@@ -468,15 +805,254 @@ static void handle_full_update(const uint8_t *payload, uint32_t length, uint16_t
     // 發送 ACK
     send_ack(seq_id);
     
+    // 發送遙測
+    send_telemetry(&tag, &stats);
+    
     // 發送 READY 訊息
     esp_websocket_client_send_text(ws_client, "READY", 5, portMAX_DELAY);
     ESP_LOGI(TAG, "========================================");
 }
 
+/**
+ * 處理繪圖指令串流
+ * 在裝置端直接繪製到 framebuffer，受影響的區域交給排程器合併刷新
+ * 
+ * ACK 與 READY 在繪製完成後立即送出，讓伺服器可以在時間窗內送出下一個更新；
+ * 刷新完成後排程器以最後一個封包的 seq_id 送出遙測
+ */
+static void handle_draw_update(const uint8_t *payload, uint32_t length, uint16_t seq_id)
+{
+    ESP_LOGI(TAG, "========================================");
+    ESP_LOGI(TAG, "Draw Command Update (%lu bytes)", length);
+    
+    uint32_t start_time = xTaskGetTickCount();
+    update_tag_t tag = {
+        .seq_id = seq_id,
+        .start_us = esp_timer_get_time(),
+        .rx_us = rx_duration_us,
+        .bytes = PROTO_HEADER_SIZE + length,
+    };
+    
+    // 繪製期間不可與排程器的刷新同時進行（刷新後會以 framebuffer 同步 0x26）
+    update_scheduler_lock();
+    
+    // framebuffer 不是面板上的畫面（開機後或暖啟動讀回失敗）：在上面繪製再部分刷新會蓋掉舊內容
+    if (!epaper.framebuffer_synced) {
+        update_scheduler_unlock();
+        ESP_LOGW(TAG, "Framebuffer not synced with panel, requesting full update");
+        send_ack_status(seq_id, ACK_STATUS_NEED_FULL);
+        esp_websocket_client_send_text(ws_client, "READY", 5, portMAX_DELAY);
+        ESP_LOGI(TAG, "========================================");
+        return;
+    }
+    
+    epaper_stats_reset(&epaper);
+    draw_bounds_t bounds;
+    esp_err_t ret = draw_commands_execute(&epaper, payload, length, &bounds);
+    epaper_stats_t stats = epaper.stats;
+    update_scheduler_unlock();
+    
+    // 字形快取統計屬於這個請求：排程器刷新前會重設統計，先記在 tag 中
+    tag.glyph_hits = stats.glyph_hits;
+    tag.glyph_misses = stats.glyph_misses;
+    tag.parse_us = (uint32_t)(esp_timer_get_time() - tag.start_us);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Draw commands failed: %s", esp_err_to_name(ret));
+        send_nak(seq_id);
+        return;
+    }
+    
+    if (!bounds.valid) {
+        ESP_LOGI(TAG, "No visible change, skipping refresh");
+        send_telemetry(&tag, &stats);
+    } else {
+        update_scheduler_submit(bounds.x0, bounds.y0,
+                                bounds.x1 - bounds.x0 + 1, bounds.y1 - bounds.y0 + 1, &tag);
+    }
+    
+    uint32_t elapsed = pdTICKS_TO_MS(xTaskGetTickCount() - start_time);
+    ESP_LOGI(TAG, "Draw update queued in %lu ms", elapsed);
+    
+    // 發送 ACK
+    send_ack(seq_id);
+    
+    // 發送 READY 訊息
+    esp_websocket_client_send_text(ws_client, "READY", 5, portMAX_DELAY);
+    ESP_LOGI(TAG, "========================================");
+}
+
+static void handle_packet(const uint8_t *data, uint32_t length, uint32_t payload_hash);
+
+/**
+ * 釋放分段組裝緩衝
+ */
+static void chunk_frame_reset(void)
+{
+    free(chunk_frame.buffer);
+    memset(&chunk_frame, 0, sizeof(chunk_frame));
+}
+
+/**
+ * 處理分段傳輸封包
+ * 
+ * Payload 格式（小端序）：
+ *   [0-1]   frame id
+ *   [2-5]   frame 總長度（內層完整封包，含 8 bytes 標頭）
+ *   [6-9]   本分段在 frame 中的位移
+ *   [10-]   分段資料
+ * 
+ * 分段必須依序送達；收到超前的分段時回傳 RESUME 要求 Server 從缺口重送。
+ * 全部收齊後，將組裝好的內層封包交給 handle_packet 處理。
+ */
+static void handle_chunk(const uint8_t *payload, uint32_t length, uint16_t seq_id)
+{
+    if (length < CHUNK_HEADER_SIZE) {
+        ESP_LOGE(TAG, "Chunk too short");
+        send_nak(seq_id);
+        return;
+    }
+    
+    uint16_t frame_id = payload[0] | (payload[1] << 8);
+    uint32_t total = payload[2] | (payload[3] << 8) | (payload[4] << 16) | ((uint32_t)payload[5] << 24);
+    uint32_t offset = payload[6] | (payload[7] << 8) | (payload[8] << 16) | ((uint32_t)payload[9] << 24);
+    const uint8_t *chunk_data = payload + CHUNK_HEADER_SIZE;
+    uint32_t chunk_len = length - CHUNK_HEADER_SIZE;
+    
+    if (total < PROTO_HEADER_SIZE || total > sizeof(packet_buffer)) {
+        ESP_LOGE(TAG, "Invalid chunked frame size: %lu", total);
+        send_nak(seq_id);
+        return;
+    }
+    
+    // 已完成 frame 的重送分段
+    if (chunk_frame.buffer == NULL && chunk_done.valid &&
+        frame_id == chunk_done.frame_id && total == chunk_done.total) {
+        ESP_LOGD(TAG, "Duplicate chunk of completed frame %d at offset %lu", frame_id, offset);
+        send_ack(seq_id);
+        return;
+    }
+    
+    // 新的 frame：捨棄之前未完成的 frame（Server 已改送新畫面）
+    if (chunk_frame.buffer == NULL || frame_id != chunk_frame.frame_id || total != chunk_frame.total) {
+        if (chunk_frame.buffer != NULL) {
+            ESP_LOGW(TAG, "Dropping incomplete frame %d (%lu/%lu bytes)",
+                     chunk_frame.frame_id, chunk_frame.received, chunk_frame.total);
+        }
+        chunk_frame_reset();
+        chunk_done.valid = false;
+        
+        chunk_frame.buffer = (uint8_t *)heap_caps_malloc(total, MALLOC_CAP_8BIT);
+        if (chunk_frame.buffer == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate chunk buffer (%lu bytes)", total);
+            send_nak(seq_id);
+            return;
+        }
+        chunk_frame.frame_id = frame_id;
+        chunk_frame.total = total;
+        chunk_frame.payload_hash = EPAPER_HASH_SEED;
+        chunk_frame.start_us = esp_timer_get_time();
+        ESP_LOGI(TAG, "Chunked frame %d started: %lu bytes", frame_id, total);
+    }
+    
+    if (offset != chunk_frame.received) {
+        // 以減法比較，避免 offset + chunk_len 溢位
+        if (offset < chunk_frame.received && chunk_len <= chunk_frame.received - offset) {
+            // 重送的舊分段，資料已經有了
+            ESP_LOGD(TAG, "Duplicate chunk at offset %lu", offset);
+            send_ack(seq_id);
+        } else {
+            // 有缺口：告知 Server 目前的位移
+            ESP_LOGW(TAG, "Chunk gap: expected offset %lu, got %lu", chunk_frame.received, offset);
+            send_resume();
+        }
+        return;
+    }
+    
+    if (chunk_len > chunk_frame.total - offset) {
+        ESP_LOGE(TAG, "Chunk exceeds frame: offset=%lu, len=%lu, total=%lu",
+                 offset, chunk_len, chunk_frame.total);
+        send_nak(seq_id);
+        return;
+    }
+    
+    memcpy(chunk_frame.buffer + offset, chunk_data, chunk_len);
+    chunk_frame.payload_hash = payload_hash_update(chunk_frame.payload_hash, offset, chunk_data, chunk_len);
+    chunk_frame.received += chunk_len;
+    send_ack(seq_id);
+    
+    ESP_LOGD(TAG, "Chunk frame %d: %lu/%lu bytes", frame_id, chunk_frame.received, chunk_frame.total);
+    
+    if (chunk_frame.received < chunk_frame.total) {
+        return;
+    }
+    
+    // 收齊：處理內層封包
+    rx_duration_us = (uint32_t)(esp_timer_get_time() - chunk_frame.start_us);
+    ESP_LOGI(TAG, "Chunked frame %d complete: %lu bytes in %lu us",
+             frame_id, chunk_frame.total, rx_duration_us);
+    
+    if (chunk_frame.buffer[1] == PROTO_TYPE_CHUNK) {
+        ESP_LOGE(TAG, "Nested chunk packets are not allowed");
+    } else {
+        handle_packet(chunk_frame.buffer, chunk_frame.total, chunk_frame.payload_hash);
+    }
+    chunk_done.frame_id = chunk_frame.frame_id;
+    chunk_done.total = chunk_frame.total;
+    chunk_done.valid = true;
+    chunk_frame_reset();
+}
+
+/**
+ * 處理控制指令
+ * 
+ * SLEEP：面板以 mode 1 保留 RAM 進入深度睡眠後 ESP32 也進入深度睡眠，
+ * 喚醒後 epaper_init() 走暖啟動流程並從面板讀回畫面。
+ * 尚在時間窗內、未刷新的 DRAW 更新會被捨棄，Server 應在收到 TELEMETRY 後再送出。
+ */
+static void handle_command(const uint8_t *payload, uint32_t length, uint16_t seq_id)
+{
+    if (length < 1) {
+        ESP_LOGE(TAG, "Command packet too short");
+        send_nak(seq_id);
+        return;
+    }
+    
+    switch (payload[0]) {
+        case CMD_SLEEP: {
+            if (length < 5) {
+                ESP_LOGE(TAG, "SLEEP command too short");
+                send_nak(seq_id);
+                return;
+            }
+            uint32_t seconds = payload[1] | (payload[2] << 8) | (payload[3] << 16) |
+                               ((uint32_t)payload[4] << 24);
+            send_ack(seq_id);
+            
+            // 等待目前的刷新結束，之後不再釋放鎖
+            update_scheduler_lock();
+            epaper_sleep(&epaper);
+            
+            if (seconds > 0) {
+                esp_sleep_enable_timer_wakeup((uint64_t)seconds * 1000000ULL);
+            }
+            ESP_LOGI(TAG, "Entering deep sleep (wake after %lu s)", seconds);
+            esp_deep_sleep_start();
+            break;
+        }
+        
+        default:
+            ESP_LOGW(TAG, "Unknown command: 0x%02X", payload[0]);
+            send_nak(seq_id);
+            break;
+    }
+}
+
 /**
  * 處理完整封包（優化為完整畫面模式）
+ * 
+ * @param payload_hash 接收時累加計算的 payload 雜湊
  */
-static void handle_packet(const uint8_t *data, uint32_t length)
+static void handle_packet(const uint8_t *data, uint32_t length, uint32_t payload_hash)
 {
     packet_header_t header;
     
@@ -493,7 +1069,8 @@ static void handle_packet(const uint8_t *data, uint32_t length)
     ESP_LOGI(TAG, "Packet: Type=0x%02X, SeqID=%d, Length=%lu", 
              header.type, header.seq_id, header.length);
     
-    if (length < PROTO_HEADER_SIZE + header.length) {
+    // 以減法比較，避免 header.length 接近 UINT32_MAX 時加法溢位
+    if (header.length > length - PROTO_HEADER_SIZE) {
         ESP_LOGE(TAG, "Incomplete packet");
         return;
     }
@@ -503,7 +1080,7 @@ static void handle_packet(const uint8_t *data, uint32_t length)
     switch (header.type) {
         case PROTO_TYPE_FULL:
             // 優先處理完整畫面更新（推薦模式，無殘影）
-            handle_full_update(payload, header.length, header.seq_id);
+            handle_full_update(payload, header.length, header.seq_id, payload_hash);
             break;
             
         case PROTO_TYPE_TILE:
@@ -513,9 +1090,16 @@ static void handle_packet(const uint8_t *data, uint32_t length)
             send_nak(header.seq_id);
             break;
             
+        case PROTO_TYPE_DRAW:
+            handle_draw_update(payload, header.length, header.seq_id);
+            break;
+            
+        case PROTO_TYPE_CHUNK:
+            handle_chunk(payload, header.length, header.seq_id);
+            break;
+            
         case PROTO_TYPE_CMD:
-            ESP_LOGI(TAG, "Command packet (not implemented)");
-            send_ack(header.seq_id);
+            handle_command(payload, header.length, header.seq_id);
             break;
             
         default:
@@ -536,6 +1120,8 @@ static void process_image_data(const uint8_t *data, size_t len)
 {
     ESP_LOGI(TAG, "Processing image data: %d bytes", len);
     
+    update_scheduler_lock();
+    
     // 清除顯示器
     epaper_clear_screen(&epaper, COLOR_WHITE);
     
@@ -552,7 +1138,8 @@ static void process_image_data(const uint8_t *data, size_t len)
     epaper_fill_rect(&epaper, 350, 250, 200, 100, COLOR_BLACK);
     
     // 顯示
-    epaper_display_full(&epaper);
+    update_scheduler_refresh_now(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    update_scheduler_unlock();
     
     ESP_LOGI(TAG, "Image displayed successfully");
 }
@@ -572,14 +1159,20 @@ static void websocket_event_handler(void *handler_args, esp_event_base_t base,
     switch (event_id) {
         case WEBSOCKET_EVENT_CONNECTED:
             ESP_LOGI(TAG, "WebSocket connected to server");
-            // 發送就緒訊息
-            esp_websocket_client_send_text(ws_client, "ESP32-C3 Ready", 14, portMAX_DELAY);
             packet_buffer_pos = 0;
+            // 發送能力協商封包，讓 Server 選擇最有效率的編碼
+            send_hello();
+            // 有未完成的分段傳輸：告知 Server 從已收到的位移續傳
+            if (chunk_frame.buffer != NULL) {
+                send_resume();
+            }
+            // 舊版 Server 仍以文字訊息判斷就緒
+            esp_websocket_client_send_text(ws_client, "ESP32-C3 Ready", 14, portMAX_DELAY);
             break;
             
         case WEBSOCKET_EVENT_DISCONNECTED:
             ESP_LOGW(TAG, "WebSocket disconnected");
-            // 完整畫面模式：只需重置封包緩衝
+            // 只重置目前的 WebSocket 封包；分段組裝狀態保留以便續傳
             packet_buffer_pos = 0;
             break;
             
@@ -600,19 +1193,28 @@ static void websocket_event_handler(void *handler_args, esp_event_base_t base,
                 // 累積所有片段直到 fin=1
                 
                 if (packet_buffer_pos + data->data_len < sizeof(packet_buffer)) {
-                    // 持續累積數據
+                    if (packet_buffer_pos == 0) {
+                        rx_start_us = esp_timer_get_time();
+                        rx_payload_hash = EPAPER_HASH_SEED;
+                    }
+                    
+                    // 持續累積數據（同時累加雜湊，收完時不需再掃一次）
                     memcpy(packet_buffer + packet_buffer_pos, data->data_ptr, data->data_len);
+                    rx_payload_hash = payload_hash_update(rx_payload_hash, packet_buffer_pos,
+                                                          (const uint8_t *)data->data_ptr, data->data_len);
                     packet_buffer_pos += data->data_len;
                     
                     // 只在接收完整訊息時處理（fin=1 且 payload 完成）
                     if (data->fin && packet_buffer_pos == data->payload_len) {
-                        ESP_LOGI(TAG, "Complete packet received: %lu bytes", packet_buffer_pos);
+                        rx_duration_us = (uint32_t)(esp_timer_get_time() - rx_start_us);
+                        ESP_LOGI(TAG, "Complete packet received: %lu bytes in %lu us",
+                                 packet_buffer_pos, rx_duration_us);
                         
                         // 檢查是否為協議封包
                         if (packet_buffer_pos >= PROTO_HEADER_SIZE && 
                             packet_buffer[0] == PROTO_HEADER) {
                             // 處理協議封包（完整畫面模式）
-                            handle_packet(packet_buffer, packet_buffer_pos);
+                            handle_packet(packet_buffer, packet_buffer_pos, rx_payload_hash);
                         } else {
                             ESP_LOGW(TAG, "Unknown binary data format (not protocol packet)");
                         }
@@ -730,10 +1332,31 @@ void app_main(void)
         return;
     }
     ESP_LOGI(TAG, "E-Paper display initialized successfully!");
+    
+    // 映射 flash 字型分區（沒有字型檔時只使用內建字型）
+    if (font_store_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Font partition unavailable, using built-in glyphs only");
+    }
+    
+    // 初始化刷新策略（使用預設門檻值）
+    refresh_policy_init(NULL);
+    
+    // 啟動部分更新排程器（合併短時間內的多個部分更新）
+    update_scheduler_config_t sched_config = UPDATE_SCHEDULER_DEFAULT_CONFIG();
+    sched_config.refresh = scheduler_refresh;
+    sched_config.batch_done = scheduler_batch_done;
+    sched_config.full_area_percent = REFRESH_POLICY_PARTIAL_AREA;
+    ret = update_scheduler_init(&epaper, &sched_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start update scheduler!");
+        return;
+    }
 
-    // 清空 framebuffer（不顯示，等待接收圖片數據）
-    epaper_clear_screen(&epaper, COLOR_WHITE);
-    ESP_LOGI(TAG, "Framebuffer cleared, ready for data reception");
+    // 清空 framebuffer（不顯示，等待接收圖片數據）；暖啟動讀回的畫面保留給之後的 DRAW
+    if (!epaper.framebuffer_synced) {
+        epaper_clear_screen(&epaper, COLOR_WHITE);
+        ESP_LOGI(TAG, "Framebuffer cleared, ready for data reception");
+    }
 
     // 初始化 WiFi
     ESP_LOGI(TAG, "Initializing WiFi...");
@@ -767,6 +1390,19 @@ void app_main(void)
             ESP_LOGI(TAG, "Min free heap: %lu bytes", esp_get_minimum_free_heap_size());
             ESP_LOGI(TAG, "Largest free block: %lu bytes", 
                      heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+            
+            glyph_cache_stats_t glyph_stats;
+            glyph_cache_get_stats(&glyph_stats);
+            uint32_t lookups = glyph_stats.hits + glyph_stats.misses;
+            ESP_LOGI(TAG, "Glyph cache: %lu hits, %lu misses (%lu%% hit rate), %lu evictions",
+                     glyph_stats.hits, glyph_stats.misses,
+                     lookups ? glyph_stats.hits * 100 / lookups : 0, glyph_stats.evictions);
+            
+            text_cache_stats_t text_stats;
+            text_cache_get_stats(&text_stats);
+            ESP_LOGI(TAG, "Text cache: %u strings, %lu bytes, %lu hits, %lu misses, %lu evictions, %lu deferred",
+                     text_stats.entries, text_stats.bytes, text_stats.hits,
+                     text_stats.misses, text_stats.evictions, text_stats.deferred);
             ESP_LOGI(TAG, "===============================");
         }
         
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+字型打包工具：將 GNU Unifont .hex 轉成 font 分區使用的字型檔 (格式見 main/font_store.h)
+
+用法：
+    python tools/font_packer.py unifont.hex font.bin --range 4E00-9FFF --range 3000-303F
+    python tools/font_packer.py unifont.hex font.bin --charset chars.txt
+    python tools/font_packer.py unifont.hex font.bin --range 4E00-9FFF --compress
+
+多種尺寸的字型檔可以直接串接後燒錄 (每個檔案都補齊到 4 bytes)：
+    cat font16.bin font24.bin font32.bin > font.bin
+
+燒錄到 font 分區：
+    parttool.py -p COM4 write_partition --partition-name font --input font.bin
+"""
+import argparse
+import struct
+import sys
+
+FONT_MAGIC = 0x54465045          # "EPFT"
+FONT_VERSION_RAW = 1
+FONT_VERSION_FLAGS = 2           # header [28-31] 為 flags
+FLAG_ROW_RLE = 0x01
+RLE_BLANK = 0x00
+RLE_REPEAT = 0x40
+RLE_LITERAL = 0x80
+RLE_MAX_COUNT = 64
+HEADER_SIZE = 32
+ENTRY_SIZE = 8
+DEFAULT_MAX_SIZE = 0x200000      # partitions.csv 中 font 分區的大小
+
+
+def parse_range(text):
+    """解析 "4E00-9FFF" 或單一碼位 "3000" """
+    if '-' in text:
+        start, end = text.split('-', 1)
+        return int(start, 16), int(end, 16)
+    cp = int(text, 16)
+    return cp, cp
+
+
+def load_unifont_hex(path, width, height):
+    """讀取 Unifont .hex，只保留指定尺寸的字形"""
+    glyph_hex_len = (width + 7) // 8 * height * 2
+    glyphs = {}
+    with open(path, 'r', encoding='ascii') as f:
+        for line_no, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            try:
+                cp_text, bitmap_hex = line.split(':', 1)
+                codepoint = int(cp_text, 16)
+            except ValueError:
+                sys.exit('{}:{}: invalid line'.format(path, line_no))
+            if len(bitmap_hex) != glyph_hex_len:
+                continue  # 其他尺寸的字形 (例如 8x16 半形字元)
+            glyphs[codepoint] = bytes.fromhex(bitmap_hex)
+    return glyphs
+
+
+def select_glyphs(glyphs, ranges, charset):
+    """依碼位範圍與字元集過濾；兩者都沒指定時保留全部"""
+    if not ranges and charset is None:
+        return dict(glyphs)
+
+    selected = {}
+    for codepoint, bitmap in glyphs.items():
+        in_range = any(start <= codepoint <= end for start, end in ranges)
+        in_charset = charset is not None and codepoint in charset
+        if in_range or in_charset:
+            selected[codepoint] = bitmap
+    return selected
+
+
+def rle_encode(bitmap, row_bytes, height):
+    """逐行 RLE 編碼 (格式見 main/glyph_rle.h)"""
+    blank = bytes(row_bytes)
+    rows = [bitmap[r * row_bytes:(r + 1) * row_bytes] for r in range(height)]
+    out = bytearray()
+    prev = blank
+    i = 0
+    while i < height:
+        if rows[i] == blank or rows[i] == prev:
+            op = RLE_BLANK if rows[i] == blank else RLE_REPEAT
+            n = 1
+            while i + n < height and n < RLE_MAX_COUNT and rows[i + n] == rows[i]:
+                n += 1
+            out.append(op | (n - 1))
+            prev = rows[i]
+            i += n
+            continue
+
+        # 原樣行：直到遇到空白行或重複行為止
+        start = i
+        i += 1
+        while i < height and i - start < RLE_MAX_COUNT and rows[i] != blank and rows[i] != rows[i - 1]:
+            i += 1
+        out.append(RLE_LITERAL | (i - start - 1))
+        for row in rows[start:i]:
+            out += row
+        prev = rows[i - 1]
+    return bytes(out)
+
+
+def rle_decode(data, row_bytes, height):
+    """解碼 (驗證用)"""
+    out = bytearray()
+    prev = bytes(row_bytes)
+    i = 0
+    while len(out) < row_bytes * height:
+        op = data[i] & 0xC0
+        n = (data[i] & 0x3F) + 1
+        i += 1
+        for _ in range(n):
+            if op == RLE_BLANK:
+                prev = bytes(row_bytes)
+            elif op == RLE_LITERAL:
+                prev = data[i:i + row_bytes]
+                i += row_bytes
+            out += prev
+    return bytes(out[:row_bytes * height])
+
+
+def pack_font(glyphs, width, height, compress=False):
+    """產生字型檔：header + 排序後的索引 + 點陣 (長度補齊到 4 bytes，方便串接)"""
+    row_bytes = (width + 7) // 8
+    glyph_bytes = row_bytes * height
+    codepoints = sorted(glyphs)
+
+    index = bytearray()
+    bitmaps = bytearray()
+    for codepoint in codepoints:
+        index += struct.pack('<II', codepoint, len(bitmaps))
+        bitmap = glyphs[codepoint]
+        if compress:
+            encoded = rle_encode(bitmap, row_bytes, height)
+            assert rle_decode(encoded, row_bytes, height) == bitmap
+            bitmap = encoded
+        bitmaps += bitmap
+
+    index_offset = HEADER_SIZE
+    bitmap_offset = index_offset + len(index)
+    file_size = (bitmap_offset + len(bitmaps) + 3) & ~3
+    padding = file_size - bitmap_offset - len(bitmaps)
+
+    version = FONT_VERSION_FLAGS if compress else FONT_VERSION_RAW
+    flags = FLAG_ROW_RLE if compress else 0
+    header = struct.pack('<IHHIBBHIIII', FONT_MAGIC, version, HEADER_SIZE,
+                         len(codepoints), width, height, glyph_bytes,
+                         index_offset, bitmap_offset, file_size, flags)
+    assert len(header) == HEADER_SIZE
+
+    return header + bytes(index) + bytes(bitmaps) + b'\0' * padding
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack a Unifont .hex file into an e-paper font partition image')
+    parser.add_argument('input', help='GNU Unifont .hex file')
+    parser.add_argument('output', help='output font file')
+    parser.add_argument('--range', action='append', default=[], type=parse_range,
+                        help='code point range to include, e.g. 4E00-9FFF (repeatable)')
+    parser.add_argument('--charset', help='UTF-8 text file; every character in it is included')
+    parser.add_argument('--width', type=int, default=16, help='glyph width (default 16)')
+    parser.add_argument('--height', type=int, default=16, help='glyph height (default 16)')
+    parser.add_argument('--compress', action='store_true', help='row-RLE compress each glyph')
+    parser.add_argument('--max-size', type=lambda v: int(v, 0), default=DEFAULT_MAX_SIZE,
+                        help='font partition size (default 0x200000)')
+    args = parser.parse_args()
+
+    charset = None
+    if args.charset:
+        with open(args.charset, 'r', encoding='utf-8') as f:
+            charset = {ord(ch) for ch in f.read() if not ch.isspace()}
+
+    glyphs = load_unifont_hex(args.input, args.width, args.height)
+    selected = select_glyphs(glyphs, args.range, charset)
+    if not selected:
+        sys.exit('no glyphs selected')
+
+    if charset is not None:
+        missing = sorted(cp for cp in charset if cp not in glyphs and cp >= 0x80)
+        if missing:
+            print('warning: {} characters not in source font: {}'.format(
+                len(missing), ''.join(chr(cp) for cp in missing[:20])))
+
+    data = pack_font(selected, args.width, args.height, args.compress)
+    if len(data) > args.max_size:
+        sys.exit('font file is {} bytes, partition is only {} bytes'.format(len(data), args.max_size))
+
+    with open(args.output, 'wb') as f:
+        f.write(data)
+
+    print('{}: {} glyphs ({}x{}), {} bytes ({:.1f}% of partition)'.format(
+        args.output, len(selected), args.width, args.height, len(data),
+        100.0 * len(data) / args.max_size))
+    if args.compress:
+        raw_size = len(pack_font(selected, args.width, args.height))
+        print('compression: {} -> {} bytes ({:.1f}% of uncompressed, {:.2f}:1)'.format(
+            raw_size, len(data), 100.0 * len(data) / raw_size, raw_size / len(data)))
+
+
+if __name__ == '__main__':
+    main()